@@ -14,7 +14,10 @@ namespace Renderer
         }
         ~AsyncQueue()
         {
-            m_run = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_run = false;
+            }
             m_conditional.notify_one();
 
             m_thread.join();
@@ -43,7 +46,7 @@ namespace Renderer
 
             while (m_run)
             {
-                m_conditional.wait(lock, [&](){ return !m_queue.empty(); });
+                m_conditional.wait(lock, [&](){ return !m_run || !m_queue.empty(); });
 
                 if (!m_queue.empty())
                 {
@@ -0,0 +1,141 @@
+#pragma once
+
+namespace Renderer
+{
+	using namespace Math;
+
+	class BVH
+	{
+	public:
+		struct Node
+		{
+			BoundingBox Bounds;
+			// Leaves: index of the first object. Interior nodes: index of the second child,
+			// the first child always directly follows its parent.
+			Size Offset = 0u;
+			Size Count = 0u;
+			Size Axis = 0u;
+
+			bool IsLeaf() const { return Count > 0u; }
+		};
+
+		// Four children per node with their bounds stored side by side, so one SIMD slab test
+		// checks every child of a node at once.
+		struct alignas(64) WideNode
+		{
+			static constexpr Size Width = 4u;
+
+			std::array<float, Width> MinX;
+			std::array<float, Width> MinY;
+			std::array<float, Width> MinZ;
+			std::array<float, Width> MaxX;
+			std::array<float, Width> MaxY;
+			std::array<float, Width> MaxZ;
+			// Leaves: index of the first object. Interior children: index of the wide node.
+			std::array<std::uint32_t, Width> Offset;
+			// Number of objects in a leaf child, zero for interior children.
+			std::array<std::uint32_t, Width> Count;
+			Size Children = 0u;
+		};
+
+		enum class Layout
+		{
+			Binary,
+			Wide
+		};
+
+		struct Settings
+		{
+			Layout NodeLayout = Layout::Wide;
+			Size MaxLeafSize = 4u;
+			float TraversalCost = 1.0f;
+			float IntersectionCost = 1.0f;
+			// Split candidates evaluated per axis by the binned SAH.
+			Size Bins = 16u;
+			// Ranges with at least this many objects are binned and split across the ThreadPool.
+			Size ParallelThreshold = 4096u;
+			// Refit rebuilds the tree once its SAH cost grows past this multiple of the cost after
+			// the last build, zero only ever refits.
+			float RebuildRatio = 2.0f;
+		};
+
+		BVH() = default;
+		explicit BVH(const std::vector<std::shared_ptr<Object>>& objects);
+		BVH(const std::vector<std::shared_ptr<Object>>& objects, const Settings& settings);
+		~BVH() = default;
+
+		void Build(const std::vector<std::shared_ptr<Object>>& objects);
+		// Recomputes node bounds after objects have moved, keeping the tree topology. Returns true
+		// if the tree degraded enough that it was rebuilt instead.
+		bool Refit();
+		// Recompiles the objects and refits if any of them were edited since the last build or
+		// commit. Returns true if anything changed, nothing is done otherwise.
+		bool Commit();
+		// Expected cost of a ray query relative to one object test, used to judge tree quality.
+		float Cost() const;
+		Intersection Intersect(const Ray& ray, const bool checkAll = true) const;
+		// Nearest object hit within the ray's interval, objects beyond the current nearest hit are culled.
+		HitRecord Closest(const Ray& ray) const;
+		// True if any object is hit within the ray's interval, stops at the first one found.
+		bool Occluded(const Ray& ray) const;
+		// Closest for every ray of the packet, each within its own interval. The packet walks the
+		// binary tree together and coherent packets skip nodes their frustum misses.
+		void Closest(const RayPacket& packet, std::array<HitRecord, RayPacket::Width>& closest) const;
+
+		const std::vector<Node>& GetNodes() const { return m_nodes; }
+		const std::vector<WideNode>& GetWideNodes() const { return m_wideNodes; }
+		const std::vector<std::shared_ptr<Object>>& GetObjects() const { return m_objects; }
+		const PrimitiveStore& GetPrimitives() const { return m_primitives; }
+		BoundingBox Bounds() const { return m_nodes.empty() ? BoundingBox() : m_nodes.front().Bounds; }
+
+	private:
+		struct Primitive
+		{
+			BoundingBox Bounds;
+			Vector3 Centroid;
+			Size Index;
+		};
+
+		// Temporary tree produced by the builder, subtrees are built in parallel and flattened afterwards.
+		struct BuildNode
+		{
+			BoundingBox Bounds;
+			Size Start = 0u;
+			Size Count = 0u;
+			Size Axis = 0u;
+			std::array<std::unique_ptr<BuildNode>, 2> Children;
+		};
+
+		struct Bin
+		{
+			BoundingBox Bounds;
+			Size Count = 0u;
+		};
+
+		std::unique_ptr<BuildNode> BuildBinned(std::vector<Primitive>& primitives, const Size start, const Size end, const Size depth) const;
+		void BinPrimitives(const std::vector<Primitive>& primitives, const Size start, const Size end, const BoundingBox& centroids, std::vector<Bin>& bins) const;
+		void Flatten(const BuildNode& node, const Size depth, Size& leaves, Size& maxDepth);
+
+		// Calls visit(start, count) with the range of objects of every leaf the ray enters between
+		// minDistance and maxDistance. maxDistance is re-read at every node so visit can shrink it,
+		// visit returns false to stop the traversal.
+		template <typename Visitor>
+		void Traverse(const Ray& ray, const float minDistance, const float& maxDistance, Visitor&& visit) const;
+		template <typename Visitor>
+		void TraverseWide(const Ray& ray, const float minDistance, const float& maxDistance, Visitor&& visit) const;
+
+		// Refit for the bounds already in m_primitives.
+		bool RefitNodes();
+
+		// Builds m_wideNodes from the binary tree by pulling up to four descendants into each node.
+		Size Collapse(const Size index);
+
+		Settings m_settings;
+		float m_buildCost = 0.0f;
+		std::vector<Node> m_nodes;
+		std::vector<WideNode> m_wideNodes;
+		std::vector<std::shared_ptr<Object>> m_objects;
+		// Copy of m_objects used by Closest and Occluded.
+		PrimitiveStore m_primitives;
+	};
+}
\ No newline at end of file
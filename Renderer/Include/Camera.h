@@ -18,6 +18,7 @@ namespace Renderer
 		Ray CreateRay(const Size pixel, const float randomMultiplier = 0.01f) const;
 
         Viewport& GetViewport() { return m_viewport; }
+        const Viewport& GetViewport() const { return m_viewport; }
 
 		float FocalLength;
 		Transform XForm;
@@ -12,13 +12,13 @@ namespace Renderer
 		constexpr float NaN = std::numeric_limits<float>::quiet_NaN();
 
 		template <typename T>
-		T Clamp(const T v, const T a, const T b)
+		constexpr T Clamp(const T v, const T a, const T b)
 		{
 			return std::min(std::max(v, std::min(a, b)), std::max(a, b));
 		}
 
 		template <typename T>
-		T Mix(const T &a, const T &b, const T &mix)
+		constexpr T Mix(const T &a, const T &b, const T &mix)
 		{
 			return b * mix + a * (static_cast<T>(1) - mix);
 		}
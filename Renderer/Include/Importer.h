@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Renderer
+{
+	// Mesh importers. Files are memory mapped and parsed in chunks on the ThreadPool straight
+	// into the Mesh buffers. Failures throw std::runtime_error.
+	//
+	// OBJ: v, vn, vt and f records are read, polygons are fan triangulated and texture and normal
+	// indices in faces are ignored. Normals and UVs are kept when there is one per position.
+	// PLY: binary little and big endian files with a vertex element (x, y, z and optionally
+	// nx, ny, nz and u, v or s, t) and a face element holding a vertex index list.
+	std::shared_ptr<Mesh> LoadMesh(const std::string& path);
+	std::shared_ptr<Mesh> LoadOBJ(const std::string& path, const Size chunkSize = Size(1u) << 22u);
+	std::shared_ptr<Mesh> LoadPLY(const std::string& path, const Size chunkSize = Size(1u) << 22u);
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+namespace Renderer
+{
+	using namespace Math;
+
+	// Places a shared bottom level BVH in the scene through its own Transform. Rays are moved
+	// into the geometry's space once per instance and hits report the instanced object, so its
+	// Material is shared between every copy. XForm may rotate and scale as well as translate.
+	class Instance : public Object
+	{
+	public:
+		Instance() = default;
+		Instance(std::shared_ptr<const BVH> geometry, const Transform& xform) :
+			Object(),
+			Geometry(std::move(geometry))
+		{
+			XForm.SetAxis(xform.GetAxis());
+			XForm.SetPosition(xform.GetPosition());
+		}
+		virtual ~Instance() {}
+
+		std::shared_ptr<const BVH> Geometry;
+
+		Vector3 ToLocal(const Vector3& position) const;
+		Vector3 ToWorld(const Vector3& position) const;
+		// Normal in world space of primitive of object, one of the instanced objects, at a world position.
+		Vector3 CalculateNormal(const Object& object, const Size primitive, const Vector3& hit) const;
+
+		Intersection Intersect(const Ray& ray) const override;
+		Vector3 CalculateNormal(const Vector3& hit) const override;
+		BoundingBox Bounds() const override;
+	};
+}
\ No newline at end of file
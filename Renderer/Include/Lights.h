@@ -11,6 +11,8 @@ namespace Renderer
 			Ray IncomingRay;
 			Vector3 Colour;
 			float Distance;
+			// Density of IncomingRay's direction per solid angle, zero when the light cannot be reached.
+			float Pdf = 0.0f;
 		};
 
 		struct SamplerSettings
@@ -31,7 +33,7 @@ namespace Renderer
 			Light() = default;
 			virtual ~Light() = default;
 
-			virtual float Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const = 0;
+			virtual float Shadow(const BVH& bvh, const Vector3& hit) const = 0;
 			// TODO: Change this so its easier to select the sampler type in the shader object. Maybe have a sampler object that can be passed in.
 			virtual Sample Sampler(const Vector3& origin, const Vector3& direction, const Vector3& up, const SamplerSettings& settings) const = 0;
 			virtual Vector3 Attenuation(const Vector3& colour, const float intensity, const float distance) const;
@@ -50,7 +52,7 @@ namespace Renderer
 				Samples = 1;
 			}
 
-			virtual float Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const override;
+			virtual float Shadow(const BVH& bvh, const Vector3& hit) const override;
 			virtual Sample Sampler(const Vector3& origin, const Vector3& direction, const Vector3& up, const SamplerSettings& settings) const override;
 
 			Transform XForm;
@@ -77,10 +79,18 @@ namespace Renderer
 			std::shared_ptr<Plane> Grid = nullptr;
 			bool RenderGeometry = false;
 
-			virtual float Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const override;
+			// Visibility of an area light is part of each light sample the shader takes, so this adds no shadow.
+			virtual float Shadow(const BVH& bvh, const Vector3& hit) const override;
 			virtual Sample Sampler(const Vector3& origin, const Vector3& direction, const Vector3& up, const SamplerSettings& settings) const override;
 
-			Vector3 SamplePlane(const float u, const float v, const Size uRegion, const Size vRegion, const float surfaceOffset = 0.0f) const;
+			// Uniformly distributed point on the light for u and v in [0, 1).
+			Sample SampleArea(const Vector3& origin, const float u, const float v) const;
+			// Density SampleArea gives the direction of ray, zero when the ray misses the light.
+			// Distance is set to the light on a hit.
+			float Pdf(const Ray& ray, float& distance) const;
+			// Radiance leaving each side of the light, the whole light is as bright as a Point light
+			// of the same Intensity seen head on.
+			Vector3 Radiance() const;
 		};
 
 		class Enviroment : public Light
@@ -110,7 +120,7 @@ namespace Renderer
 
 			std::vector<Plane> CubeMap;
 
-			virtual float Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const override;
+			virtual float Shadow(const BVH& bvh, const Vector3& hit) const override;
 			virtual Sample Sampler(const Vector3& hit, const Vector3& view, const Vector3& normal, const SamplerSettings& settings) const override;
 
 			Intersection SampleCubeMap(const Ray& ray) const;
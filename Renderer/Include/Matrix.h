@@ -123,24 +123,245 @@ namespace Renderer
 			std::vector<T> m_data;
 		};
 
+		// Fixed size square matrix stored inline, used for transforms in the hot path.
 		template <typename T, Size SIZE>
-		class SquareMatrix : public Matrix<T>
+		class SquareMatrix
 		{
 		public:
-			SquareMatrix() : Matrix(SIZE, SIZE) {}
-			SquareMatrix(const T value) : Matrix(value, SIZE, SIZE) {}
-			SquareMatrix(std::vector<T> data) : Matrix(std::move(data), SIZE, SIZE) {}
-			SquareMatrix(const std::initializer_list<std::initializer_list<T>>& mat) : Matrix(mat)
+			constexpr SquareMatrix() : m_data{} {}
+			constexpr SquareMatrix(const T value) : m_data{}
+			{
+				for (auto& v : m_data) { v = value; }
+			}
+			SquareMatrix(const std::vector<T>& data) : m_data{}
+			{
+				if (data.size() != SIZE * SIZE)
+					throw std::logic_error("Row and Columns area does not match data size.");
+				std::copy(data.begin(), data.end(), m_data.begin());
+			}
+			SquareMatrix(const std::initializer_list<std::initializer_list<T>>& mat) : m_data{}
 			{
 				Size rows = mat.size();
 				Size columns = (*mat.begin()).size();
 				if (rows * columns != SIZE * SIZE)
 					throw std::logic_error("Incorrect number of arguments.");
+
+				Size i = 0;
+				for (const auto& r : mat)
+				{
+					for (const auto& c : r)
+					{
+						m_data[i++] = c;
+					}
+				}
 			}
-			~SquareMatrix() {}
+
+			SquareMatrix(const SquareMatrix &rhs) = default;
+			SquareMatrix(SquareMatrix &&rhs) = default;
+			SquareMatrix& operator=(const SquareMatrix& rhs) = default;
+			SquareMatrix& operator=(SquareMatrix&& rhs) = default;
+
+			// Matrix functions
+			constexpr void Identity();
+			constexpr void Transpose();
+			constexpr T Determinant() const;
+			void Inverse() { *this = Inversed(); }
+			SquareMatrix Inversed() const;
+			constexpr SquareMatrix Multiply(const SquareMatrix& matrix) const;
+
+			// Accessors
+			constexpr T& operator[] (Size i) { return m_data[i]; }
+			constexpr const T& operator[] (Size i) const { return m_data[i]; }
+
+			constexpr Size Area() const { return SIZE * SIZE; }
+			constexpr Size Rows() const { return SIZE; }
+			constexpr Size Columns() const { return SIZE; }
+
+			constexpr T Get(const Size c, const Size r) const { return m_data[(SIZE * r) + c]; }
+			constexpr void Set(const Size c, const Size r, const T value) { m_data[(SIZE * r) + c] = value; }
+			constexpr std::array<T, SIZE * SIZE>& Data() { return m_data; }
+			constexpr const std::array<T, SIZE * SIZE>& Data() const { return m_data; }
+
+			// Operators
+			constexpr SquareMatrix operator* (const SquareMatrix& rhs) const { CUSTOM_OPERATOR_MATRIX(*) }
+			constexpr SquareMatrix operator+ (const SquareMatrix& rhs) const { CUSTOM_OPERATOR_MATRIX(+) }
+			constexpr SquareMatrix operator- (const SquareMatrix& rhs) const { CUSTOM_OPERATOR_MATRIX(-) }
+			constexpr SquareMatrix operator/ (const SquareMatrix& rhs) const { CUSTOM_OPERATOR_MATRIX(/) }
+
+			constexpr SquareMatrix& operator*= (const SquareMatrix& rhs) { CUSTOM_OPERATOR_MATRIX_EQUALS(*) }
+			constexpr SquareMatrix& operator+= (const SquareMatrix& rhs) { CUSTOM_OPERATOR_MATRIX_EQUALS(+) }
+			constexpr SquareMatrix& operator-= (const SquareMatrix& rhs) { CUSTOM_OPERATOR_MATRIX_EQUALS(-) }
+			constexpr SquareMatrix& operator/= (const SquareMatrix& rhs) { CUSTOM_OPERATOR_MATRIX_EQUALS(/) }
+
+			constexpr SquareMatrix operator* (const T& rhs) const { CUSTOM_OPERATOR_MATRIX_T(*) }
+			constexpr SquareMatrix operator+ (const T& rhs) const { CUSTOM_OPERATOR_MATRIX_T(+) }
+			constexpr SquareMatrix operator- (const T& rhs) const { CUSTOM_OPERATOR_MATRIX_T(-) }
+			constexpr SquareMatrix operator/ (const T& rhs) const { CUSTOM_OPERATOR_MATRIX_T(/) }
+
+			constexpr SquareMatrix& operator*= (const T& rhs) { CUSTOM_OPERATOR_MATRIX_T_EQUALS(*) }
+			constexpr SquareMatrix& operator+= (const T& rhs) { CUSTOM_OPERATOR_MATRIX_T_EQUALS(+) }
+			constexpr SquareMatrix& operator-= (const T& rhs) { CUSTOM_OPERATOR_MATRIX_T_EQUALS(-) }
+			constexpr SquareMatrix& operator/= (const T& rhs) { CUSTOM_OPERATOR_MATRIX_T_EQUALS(/) }
+
+		private:
+			std::array<T, SIZE * SIZE> m_data;
 		};
 
+		template <typename T, Size SIZE>
+		constexpr void SquareMatrix<T, SIZE>::Identity()
+		{
+			for (Size i = 0; i < SIZE * SIZE; ++i)
+			{
+				m_data[i] = (i % (SIZE + 1)) == 0 ? static_cast<T>(1) : static_cast<T>(0);
+			}
+		}
+
+		template <typename T, Size SIZE>
+		constexpr void SquareMatrix<T, SIZE>::Transpose()
+		{
+			for (Size r = 0; r < SIZE; ++r)
+			{
+				for (Size c = r + 1; c < SIZE; ++c)
+				{
+					const T value = m_data[(SIZE * r) + c];
+					m_data[(SIZE * r) + c] = m_data[(SIZE * c) + r];
+					m_data[(SIZE * c) + r] = value;
+				}
+			}
+		}
+
+		template <typename T, Size SIZE>
+		constexpr T SquareMatrix<T, SIZE>::Determinant() const
+		{
+			const auto& m = m_data;
+			if constexpr (SIZE == 2)
+			{
+				return (m[0] * m[3]) - (m[1] * m[2]);
+			}
+			else if constexpr (SIZE == 3)
+			{
+				return m[0] * ((m[4] * m[8]) - (m[5] * m[7])) +
+					m[1] * ((m[5] * m[6]) - (m[3] * m[8])) +
+					m[2] * ((m[3] * m[7]) - (m[4] * m[6]));
+			}
+			else if constexpr (SIZE == 4)
+			{
+				const T s0 = (m[0] * m[5]) - (m[4] * m[1]);
+				const T s1 = (m[0] * m[6]) - (m[4] * m[2]);
+				const T s2 = (m[0] * m[7]) - (m[4] * m[3]);
+				const T s3 = (m[1] * m[6]) - (m[5] * m[2]);
+				const T s4 = (m[1] * m[7]) - (m[5] * m[3]);
+				const T s5 = (m[2] * m[7]) - (m[6] * m[3]);
+				const T c5 = (m[10] * m[15]) - (m[14] * m[11]);
+				const T c4 = (m[9] * m[15]) - (m[13] * m[11]);
+				const T c3 = (m[9] * m[14]) - (m[13] * m[10]);
+				const T c2 = (m[8] * m[15]) - (m[12] * m[11]);
+				const T c1 = (m[8] * m[14]) - (m[12] * m[10]);
+				const T c0 = (m[8] * m[13]) - (m[12] * m[9]);
+				return (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+			}
+			else
+			{
+				return Matrix<T>(std::vector<T>(m.begin(), m.end()), SIZE, SIZE).Determinant();
+			}
+		}
+
+		template <typename T, Size SIZE>
+		SquareMatrix<T, SIZE> SquareMatrix<T, SIZE>::Inversed() const
+		{
+			const auto& m = m_data;
+			SquareMatrix<T, SIZE> result;
+			auto& r = result.m_data;
+
+			if constexpr (SIZE == 3)
+			{
+				r[0] = (m[4] * m[8]) - (m[5] * m[7]);
+				r[1] = (m[2] * m[7]) - (m[1] * m[8]);
+				r[2] = (m[1] * m[5]) - (m[2] * m[4]);
+				r[3] = (m[5] * m[6]) - (m[3] * m[8]);
+				r[4] = (m[0] * m[8]) - (m[2] * m[6]);
+				r[5] = (m[2] * m[3]) - (m[0] * m[5]);
+				r[6] = (m[3] * m[7]) - (m[4] * m[6]);
+				r[7] = (m[1] * m[6]) - (m[0] * m[7]);
+				r[8] = (m[0] * m[4]) - (m[1] * m[3]);
+
+				const T determinant = (m[0] * r[0]) + (m[1] * r[3]) + (m[2] * r[6]);
+				if (determinant == static_cast<T>(0))
+				{
+					throw std::logic_error("Matrix is singular.");
+				}
+				result *= static_cast<T>(1) / determinant;
+			}
+			else if constexpr (SIZE == 4)
+			{
+				const T s0 = (m[0] * m[5]) - (m[4] * m[1]);
+				const T s1 = (m[0] * m[6]) - (m[4] * m[2]);
+				const T s2 = (m[0] * m[7]) - (m[4] * m[3]);
+				const T s3 = (m[1] * m[6]) - (m[5] * m[2]);
+				const T s4 = (m[1] * m[7]) - (m[5] * m[3]);
+				const T s5 = (m[2] * m[7]) - (m[6] * m[3]);
+				const T c5 = (m[10] * m[15]) - (m[14] * m[11]);
+				const T c4 = (m[9] * m[15]) - (m[13] * m[11]);
+				const T c3 = (m[9] * m[14]) - (m[13] * m[10]);
+				const T c2 = (m[8] * m[15]) - (m[12] * m[11]);
+				const T c1 = (m[8] * m[14]) - (m[12] * m[10]);
+				const T c0 = (m[8] * m[13]) - (m[12] * m[9]);
+
+				const T determinant = (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+				if (determinant == static_cast<T>(0))
+				{
+					throw std::logic_error("Matrix is singular.");
+				}
+
+				r[0] = (m[5] * c5) - (m[6] * c4) + (m[7] * c3);
+				r[1] = -(m[1] * c5) + (m[2] * c4) - (m[3] * c3);
+				r[2] = (m[13] * s5) - (m[14] * s4) + (m[15] * s3);
+				r[3] = -(m[9] * s5) + (m[10] * s4) - (m[11] * s3);
+				r[4] = -(m[4] * c5) + (m[6] * c2) - (m[7] * c1);
+				r[5] = (m[0] * c5) - (m[2] * c2) + (m[3] * c1);
+				r[6] = -(m[12] * s5) + (m[14] * s2) - (m[15] * s1);
+				r[7] = (m[8] * s5) - (m[10] * s2) + (m[11] * s1);
+				r[8] = (m[4] * c4) - (m[5] * c2) + (m[7] * c0);
+				r[9] = -(m[0] * c4) + (m[1] * c2) - (m[3] * c0);
+				r[10] = (m[12] * s4) - (m[13] * s2) + (m[15] * s0);
+				r[11] = -(m[8] * s4) + (m[9] * s2) - (m[11] * s0);
+				r[12] = -(m[4] * c3) + (m[5] * c1) - (m[6] * c0);
+				r[13] = (m[0] * c3) - (m[1] * c1) + (m[2] * c0);
+				r[14] = -(m[12] * s3) + (m[13] * s1) - (m[14] * s0);
+				r[15] = (m[8] * s3) - (m[9] * s1) + (m[10] * s0);
+				result *= static_cast<T>(1) / determinant;
+			}
+			else
+			{
+				const auto inverse = Matrix<T>(std::vector<T>(m.begin(), m.end()), SIZE, SIZE).Inversed();
+				std::copy(inverse.Data().begin(), inverse.Data().end(), r.begin());
+			}
+
+			return result;
+		}
+
+		template <typename T, Size SIZE>
+		constexpr SquareMatrix<T, SIZE> SquareMatrix<T, SIZE>::Multiply(const SquareMatrix<T, SIZE>& matrix) const
+		{
+			SquareMatrix<T, SIZE> result;
+			for (Size r = 0; r < SIZE; ++r)
+			{
+				for (Size c = 0; c < SIZE; ++c)
+				{
+					T sum = static_cast<T>(0);
+					for (Size i = 0; i < SIZE; ++i)
+					{
+						sum += m_data[(SIZE * r) + i] * matrix.m_data[(SIZE * i) + c];
+					}
+					result.m_data[(SIZE * r) + c] = sum;
+				}
+			}
+			return result;
+		}
+
 		using Matrix3 = SquareMatrix<float, 3>;
 		using Matrix4 = SquareMatrix<float, 4>;
+
+		static_assert(std::is_trivially_copyable<Matrix3>::value, "Matrix3 must stay trivially copyable.");
 	}
 }
\ No newline at end of file
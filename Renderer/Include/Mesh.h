@@ -0,0 +1,101 @@
+#pragma once
+
+namespace Renderer
+{
+	using namespace Math;
+
+	// Indexed triangle mesh. Vertex attributes are kept as separate arrays per component and
+	// the triangles are sorted into an internal BVH whose leaves hold packets of four, tested
+	// together with one SIMD Moller-Trumbore kernel. Vertices are in world space, place copies
+	// of a mesh with an Instance.
+	class Mesh : public Object
+	{
+	public:
+		struct Buffer3
+		{
+			std::vector<float> X;
+			std::vector<float> Y;
+			std::vector<float> Z;
+
+			Size Count() const { return X.size(); }
+			Vector3 Get(const Size i) const { return { X[i], Y[i], Z[i] }; }
+			void Push(const Vector3& value) { X.push_back(value[0]); Y.push_back(value[1]); Z.push_back(value[2]); }
+		};
+
+		struct Buffer2
+		{
+			std::vector<float> U;
+			std::vector<float> V;
+
+			Size Count() const { return U.size(); }
+			Vector2 Get(const Size i) const { return { U[i], V[i] }; }
+			void Push(const Vector2& value) { U.push_back(value[0]); V.push_back(value[1]); }
+		};
+
+		Mesh() = default;
+		Mesh(Buffer3 positions, std::vector<std::uint32_t> indices, Buffer3 normals = Buffer3(), Buffer2 uvs = Buffer2()) :
+			Object(),
+			Positions(std::move(positions)),
+			Normals(std::move(normals)),
+			UVs(std::move(uvs)),
+			Indices(std::move(indices))
+		{
+			Build();
+		}
+		virtual ~Mesh() {}
+
+		// Normals and UVs are optional, when present they hold one entry per position.
+		Buffer3 Positions;
+		Buffer3 Normals;
+		Buffer2 UVs;
+		// Three position indices per triangle.
+		std::vector<std::uint32_t> Indices;
+
+		// Rebuilds the triangle hierarchy, call after the buffers have been modified.
+		void Build();
+		Size TriangleCount() const { return Indices.size() / 3u; }
+		Vector3 Barycentric(const Vector3& hit, const Size triangle) const;
+		Vector2 CalculateUV(const Vector3& hit, const Size triangle) const;
+
+		Intersection Intersect(const Ray& ray) const override;
+		Vector3 CalculateNormal(const Vector3& hit) const override;
+		Vector3 CalculateNormal(const Vector3& hit, const Size triangle) const override;
+		BoundingBox Bounds() const override;
+
+	private:
+		// Four triangles stored as one vertex and two edges, lanes past the last triangle are
+		// degenerate and never hit.
+		struct alignas(16) Packet
+		{
+			static constexpr Size Width = 4u;
+
+			std::array<float, Width> V0X;
+			std::array<float, Width> V0Y;
+			std::array<float, Width> V0Z;
+			std::array<float, Width> E1X;
+			std::array<float, Width> E1Y;
+			std::array<float, Width> E1Z;
+			std::array<float, Width> E2X;
+			std::array<float, Width> E2Y;
+			std::array<float, Width> E2Z;
+			std::array<std::uint32_t, Width> Triangle;
+		};
+
+		struct Node
+		{
+			BoundingBox Bounds;
+			// Leaves: index of the packet. Interior nodes: index of the second child, the first
+			// child always directly follows its parent.
+			std::uint32_t Offset = 0u;
+			std::uint32_t Axis = 0u;
+			bool Leaf = false;
+		};
+
+		Size BuildRecursive(std::vector<std::uint32_t>& triangles, const std::vector<BoundingBox>& bounds, const Size start, const Size end);
+		// Closest hit in packet nearer than distance, returns the lane or Packet::Width on a miss.
+		Size IntersectPacket(const Packet& packet, const Ray& ray, float& distance) const;
+
+		std::vector<Node> m_nodes;
+		std::vector<Packet> m_packets;
+	};
+}
\ No newline at end of file
@@ -14,7 +14,10 @@ namespace Renderer
 		~Object() = default;
 
 		virtual Vector3 CalculateNormal(const Vector3& hit) const = 0;
+		// Objects made of several parts use the primitive reported by Intersect.
+		virtual Vector3 CalculateNormal(const Vector3& hit, const Size primitive) const { return CalculateNormal(hit); }
 		virtual Intersection Intersect(const Ray& ray) const = 0;
+		virtual BoundingBox Bounds() const = 0;
 
 		Transform XForm;
 		Shader Material;
@@ -44,8 +47,25 @@ namespace Renderer
 		Vector3 UVToWorld(const float u, const float v, const float surfaceOffset = 0.0f) const;
 		void SetDirection(const Vector3& direction);
 
+		// Everything Intersect derives from XForm and the size, baked once by Scene::Commit.
+		struct Compiled
+		{
+			Vector3 Position;
+			Vector3 Normal;
+			// Rows of the inverse axis giving the position across the width and height.
+			Vector3 U;
+			Vector3 V;
+			float HalfWidth = 5.0f;
+			float HalfHeight = 5.0f;
+		};
+
+		Compiled Compile() const;
+		// Distance along ray to the plane, Infinity on a miss.
+		static float HitDistance(const Compiled& plane, const Ray& ray);
+
 		virtual Vector3 CalculateNormal(const Vector3& hit) const override;
 		virtual Intersection Intersect(const Ray& ray) const override;
+		virtual BoundingBox Bounds() const override;
 	};
 
 	class Sphere : public Object
@@ -56,8 +76,24 @@ namespace Renderer
 
 		float Radius = 1.0f;
 
+		struct Compiled
+		{
+			Vector3 Centre;
+			float RadiusSquared = 1.0f;
+		};
+
+		static constexpr Size BatchWidth = 4u;
+
+		Compiled Compile() const { return { XForm.GetPosition(), Radius * Radius }; }
+		// Distance along ray to the sphere, the far side when the ray starts inside, Infinity on a miss.
+		static float HitDistance(const Compiled& sphere, const Ray& ray);
+		// HitDistance for BatchWidth spheres at once, given one array per field. Every distance is
+		// bit for bit what HitDistance returns for that sphere.
+		static void HitDistances(const float* x, const float* y, const float* z, const float* radiusSquared, const Ray& ray, float* distances);
+
 		Intersection Intersect(const Ray& ray) const override;
 		Vector3 CalculateNormal(const Vector3& hit) const override;
+		BoundingBox Bounds() const override;
 	};
 
 	class Cube : public Object
@@ -70,7 +106,18 @@ namespace Renderer
 		float Height = 1.0f;
 		float Length = 1.0f;
 
+		struct Compiled
+		{
+			Vector3 Min;
+			Vector3 Max;
+		};
+
+		Compiled Compile() const;
+		// Distance along ray to the box, Infinity on a miss or when the ray starts inside.
+		static float HitDistance(const Compiled& cube, const Ray& ray);
+
 		Intersection Intersect(const Ray& ray) const override;
 		Vector3 CalculateNormal(const Vector3& hit) const override;
+		BoundingBox Bounds() const override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+namespace Renderer
+{
+	using namespace Math;
+
+	// Compiled copy of the objects a BVH was built over. The built-in primitives are compiled by
+	// concrete type into contiguous arrays and tested with direct calls, without going through
+	// the shared_ptr and the virtual Intersect. Anything else, meshes and instances included,
+	// is kept as an Object pointer and called as before. The bounds of every object are kept too.
+	// It also works as a flat list on its own, spheres next to each other are tested in batches.
+	class PrimitiveStore
+	{
+	public:
+		enum class Type : std::uint8_t
+		{
+			Sphere,
+			Plane,
+			Cube,
+			Other
+		};
+
+		// Exact type of object, classes derived from the built-in primitives count as Other as
+		// they may override Intersect.
+		static Type Classify(const Object& object);
+
+		// objects are stored in the order given, which the BVH keeps as leaf order with the
+		// objects of each leaf grouped by Type.
+		void Build(const std::vector<std::shared_ptr<Object>>& objects);
+		// Recompiles the objects Build was given, in the same order. Returns true if any of them changed.
+		bool Update(const std::vector<std::shared_ptr<Object>>& objects);
+		void Clear();
+		Size Count() const { return m_slots.size(); }
+		Type GetType(const Size i) const { return m_slots[i].Kind; }
+		const BoundingBox& GetBounds(const Size i) const { return m_bounds[i]; }
+
+		// Updates closest if one of the objects in [start, start + count) is hit within the ray's
+		// interval and before closest.Distance.
+		void Closest(const Ray& ray, const Size start, const Size count, HitRecord& closest) const;
+		// True if one of the objects in [start, start + count) is hit before the ray's maximum distance.
+		bool Occluded(const Ray& ray, const Size start, const Size count) const;
+
+	private:
+		struct Slot
+		{
+			Type Kind = Type::Other;
+			// Index into the array of Kind.
+			std::uint32_t Index = 0u;
+		};
+
+		// Calls visit(object, intersection) for every object in [start, start + count) hit by
+		// ray. Runs of one Type are tested together against their array, visit returns false to stop.
+		template <typename Visitor>
+		void Visit(const Ray& ray, const Size start, const Size count, Visitor&& visit) const;
+
+		// Compiles object i into the arrays, returns true if anything differs from what was there.
+		bool Compile(const Object& object, const Size i);
+
+		std::vector<Slot> m_slots;
+		std::vector<const Object*> m_objects;
+		std::vector<BoundingBox> m_bounds;
+		// Compiled spheres with one array per field, padded so a whole batch can always be loaded.
+		struct SphereArrays
+		{
+			std::vector<float> X;
+			std::vector<float> Y;
+			std::vector<float> Z;
+			std::vector<float> RadiusSquared;
+
+			void Resize(const Size count);
+			bool Assign(const Size i, const Sphere::Compiled& sphere);
+		};
+
+		SphereArrays m_spheres;
+		Size m_sphereCount = 0u;
+		std::vector<Plane::Compiled> m_planes;
+		std::vector<Cube::Compiled> m_cubes;
+	};
+}
\ No newline at end of file
@@ -5,6 +5,33 @@ namespace Renderer
 	using namespace Math;
 	using namespace Lights;
 
+	// Rays waiting to go through the stages of the wavefront integrator. Every field has its own
+	// array so a stage only streams through the data it reads and writes.
+	struct RayQueue
+	{
+		void Push(const Ray& ray, const Vector3& weight, const std::uint32_t pixel, const RandomGenerator& generator);
+		void Clear();
+		Size Count() const { return Origins.size(); }
+		Ray GetRay(const Size i) const { return Ray(Origins[i], Directions[i]); }
+
+		// Filled by the generate and shade stages.
+		std::vector<Vector3> Origins;
+		std::vector<Vector3> Directions;
+		// Fraction of the ray's radiance that reaches its pixel.
+		std::vector<Vector3> Weights;
+		std::vector<std::uint32_t> Pixels;
+		std::vector<RandomGenerator> Generators;
+		// Filled by the extend stage, Order lists the rays grouped by the object they hit.
+		std::vector<HitRecord> Hits;
+		std::vector<std::uint32_t> Order;
+		// Filled by the connect stage, Positions are already offset from the surface.
+		std::vector<Vector3> Positions;
+		std::vector<Vector3> Normals;
+		std::vector<float> Shadows;
+		// Filled by the shade stage and added to the pixels by the accumulate stage.
+		std::vector<Vector3> Radiance;
+	};
+
 	class Scene
 	{
 	public:
@@ -16,6 +43,7 @@ namespace Renderer
 			Lights(std::move(Lights)),
 			Cam(camera)
 		{ 
+			Build();
 		}
 
 		Scene() = default;
@@ -24,14 +52,52 @@ namespace Renderer
 		Scene(Scene&&) = delete;
 		Scene& operator=(const Scene& scene) = delete;
 
+		// Rebuilds the acceleration structure, call after Objects has been modified.
+		void Build() { Hierarchy.Build(Objects); }
+		void Build(const BVH::Settings& settings) { Hierarchy = BVH(Objects, settings); }
+
+		// Bakes edits to Objects into the compiled primitives the renderer reads, call between
+		// renders after objects have been changed. Unchanged objects cost a compare, the hierarchy
+		// is refitted when any object changed and rebuilt if objects were added, removed or replaced.
+		void Commit()
+		{
+			const auto sorted = [](const std::vector<std::shared_ptr<Object>>& objects)
+			{
+				std::vector<const Object*> pointers(objects.size());
+				std::transform(objects.begin(), objects.end(), pointers.begin(), [](const auto& object) { return object.get(); });
+				std::sort(pointers.begin(), pointers.end());
+				return pointers;
+			};
+
+			// The hierarchy keeps its own copy of the objects, any difference means a rebuild.
+			if (sorted(Objects) != sorted(Hierarchy.GetObjects()))
+			{
+				Build();
+				return;
+			}
+			Hierarchy.Commit();
+		}
+		void Update() { Commit(); }
+
 		std::vector<std::shared_ptr<Object>> Objects;
 		std::vector<std::shared_ptr<Light>> Lights;
 		Camera Cam = Camera(1024, 1024);
+		BVH Hierarchy;
 	};
 
 	class RayTracer
 	{
 	public:
+		enum class Integrator
+		{
+			// Trace recurses through each camera ray in turn.
+			Recursive,
+			// Rays of a tile move through generate, extend, connect, shade and accumulate stages in batches.
+			Wavefront,
+			// Each camera ray follows a single bounce per hit up to MaxGIDepth, ended early by Russian roulette.
+			Path
+		};
+
 		struct Settings
 		{
 			Vector3 BackgroundColour = { 0.0f, 0.0f, 0.0f };
@@ -39,6 +105,34 @@ namespace Renderer
 			Size MaxDepth = 2u;
 			Size MaxGIDepth = 2u;
 			Size SecondryBounces = 10u;
+			Size Seed = 0u;
+			Size TileSize = 32u;
+			TileOrder Order = TileOrder::Hilbert;
+			// Traces camera rays through the BVH in packets of 4x4 pixels, the image is the same.
+			bool PacketTracing = false;
+			Integrator Mode = Integrator::Recursive;
+			// Most rays a wavefront stage works on at once, bounds the memory of the queues.
+			Size WavefrontSize = 1u << 16u;
+			// Path bounces after which Russian roulette may end a path.
+			Size RouletteDepth = 3u;
+			// Adaptive sampling for the Recursive and Path integrators. Every pixel takes MinSamples,
+			// then the rest of the image's SamplesPerPixel budget goes to the noisiest pixels until
+			// the standard error of their luminance is below ErrorThreshold or they reach MaxSamples.
+			bool Adaptive = false;
+			Size MinSamples = 8u;
+			Size MaxSamples = 64u;
+			float ErrorThreshold = 0.005f;
+			// Progressive rendering for the Recursive and Path integrators. Passes of PassSamples
+			// samples per pixel are added to an accumulation buffer and the image is shown after each
+			// one, until every pixel has SamplesPerPixel, TimeBudget has passed or the next pass would
+			// take more than SampleBudget samples in total. A zero budget is no limit.
+			bool Progressive = false;
+			Size PassSamples = 1u;
+			std::chrono::milliseconds TimeBudget = std::chrono::milliseconds(0);
+			Size SampleBudget = 0u;
+			// Numbers the Recursive and Path integrators draw for each sample of a pixel. Packet
+			// tracing and the Wavefront integrator always draw independent numbers.
+			SamplerType Sampling = SamplerType::Independent;
 		};
 
 		RayTracer() = delete;
@@ -58,11 +152,32 @@ namespace Renderer
 
 		Intersection Trace(const Ray& ray, const Size depth = 0u) const;
 
+		// Samples taken by every pixel in the last render.
+		const Matrix<Size>& GetSampleCounts() const { return mSampleCounts; }
+
 	private:
+		// Colour of one camera sample of a pixel with the Recursive or Path integrator.
+		Vector3 Sample(const Size index, const Size sample) const;
+		void RenderAdaptive(const std::vector<Tile>& tiles, const std::function<void()>& save);
+		void RenderProgressive(const std::vector<Tile>& tiles, const std::function<void()>& save);
+		// Shading of a ray whose closest hit has already been found.
+		Intersection Shade(const Ray& ray, const HitRecord& closest, const Size depth) const;
+		// Colour of a camera ray under the Path integrator, closest is where the ray hits first.
+		Vector3 TracePath(Ray ray, HitRecord closest) const;
+		void TracePackets(const Tile& tile, std::vector<Vector3>& colours) const;
+
+		// Wavefront integrator, produces the same estimate as Trace one stage at a time.
+		void TraceWavefront(const Tile& tile, std::vector<Vector3>& colours) const;
+		void Flush(std::vector<RayQueue>& queues, const Size depth, std::vector<Vector3>& colours) const;
+		void Extend(RayQueue& queue, const Size depth) const;
+		void Connect(RayQueue& queue) const;
+		void Shade(RayQueue& queue, const Size start, const Size end, const Size depth, RayQueue& next) const;
+		void Accumulate(const RayQueue& queue, std::vector<Vector3>& colours) const;
 		Vector3 GlobalIllumination(const Ray& ray, const Vector3& normal, const Vector3& hit, const Size depth) const;
 
 		const std::reference_wrapper<const Scene> mScene;
 		Camera mCamera;
 		const Settings mSettings;
+		Matrix<Size> mSampleCounts;
 	};
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <memory>
 #include <string>
 #include <iostream>
@@ -28,6 +29,15 @@
 #include <queue>
 #include <deque>
 #include <optional>
+#include <cstdint>
+#include <typeinfo>
+#include <cstring>
+#include <charconv>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define RENDERER_SSE
+#include <immintrin.h>
+#endif
 
 #define _USE_MATH_DEFINES
 
@@ -40,9 +50,16 @@
 #include "Vector.h"
 #include "ThreadPool.h"
 #include "Utilities.h"
+#include "Sampler.h"
 #include "Shader.h"
 #include "Objects.h"
+#include "Mesh.h"
+#include "PrimitiveStore.h"
+#include "BVH.h"
+#include "Instance.h"
+#include "Importer.h"
 #include "Lights.h"
+#include "Tiles.h"
 #include "Viewport.h"
 #include "Camera.h"
 #include "RayTracer.h"
\ No newline at end of file
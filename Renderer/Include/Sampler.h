@@ -0,0 +1,72 @@
+#pragma once
+
+namespace Renderer
+{
+	enum class SamplerType
+	{
+		// Independent uniform numbers, the same as Random without a sampler.
+		Independent,
+		// Every dimension split into one stratum per sample, strata shuffled per pixel and dimension.
+		Stratified,
+		// Sobol points in dimension pairs with nested uniform scrambling per pixel.
+		Sobol,
+		// Halton sequence with a random rotation per pixel and dimension.
+		Halton
+	};
+
+	// Source of the numbers Random returns while a sample of a pixel is rendered. Each call to
+	// Next moves on to the next dimension of the sample, so the camera, lights and bounces of a
+	// path each draw from their own well distributed stream.
+	class Sampler
+	{
+	public:
+		virtual ~Sampler() = default;
+
+		// Starts sample index of count for a pixel, seed decorrelates whole renders.
+		virtual void Start(const std::uint64_t pixel, const Size index, const Size count, const std::uint64_t seed);
+		// Next dimension of the current sample in [0, 1).
+		virtual float Next() = 0;
+
+	protected:
+		// Hash of the pixel and seed, used to scramble every dimension differently per pixel.
+		std::uint32_t m_scramble = 0u;
+		Size m_index = 0u;
+		Size m_count = 1u;
+		Size m_dimension = 0u;
+		// Fallback for dimensions a sequence does not cover.
+		RandomGenerator m_generator;
+	};
+
+	class IndependentSampler : public Sampler
+	{
+	public:
+		float Next() override;
+	};
+
+	class StratifiedSampler : public Sampler
+	{
+	public:
+		float Next() override;
+	};
+
+	class SobolSampler : public Sampler
+	{
+	public:
+		float Next() override;
+
+	private:
+		float m_pending = 0.0f;
+	};
+
+	class HaltonSampler : public Sampler
+	{
+	public:
+		float Next() override;
+	};
+
+	std::unique_ptr<Sampler> CreateSampler(const SamplerType type);
+
+	// Sampler used by Random on this thread, nullptr draws from ThreadRandomGenerator.
+	Sampler* ThreadSampler();
+	void SetThreadSampler(Sampler* sampler);
+}
\ No newline at end of file
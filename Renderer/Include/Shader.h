@@ -5,6 +5,7 @@ namespace Renderer
 	namespace Lights
 	{
 		class Light;
+		class Area;
 	}
 
 	using namespace Math;
@@ -50,17 +51,32 @@ namespace Renderer
 		Vector3 BSDF(const Ray& ray, 
 			const Vector3& normal, 
 			const Vector3& hit, 
-			const std::vector<std::shared_ptr<Object>>& objects, 
+			const BVH& bvh, 
 			const std::vector<std::shared_ptr<Light>>& lights) const;
 
+		// As above with the result of Shadow already known.
+		Vector3 BSDF(const Ray& ray,
+			const Vector3& normal,
+			const Vector3& hit,
+			const BVH& bvh,
+			const std::vector<std::shared_ptr<Light>>& lights,
+			const float shadow) const;
+
 		Vector3 BRDF(const Ray& ray, 
 			const Vector3& normal, 
 			const Vector3& hit, 
-			const std::vector<std::shared_ptr<Object>>& objects, 
+			const BVH& bvh, 
 			const std::vector<std::shared_ptr<Light>>& lights) const;
 
+		Vector3 BRDF(const Ray& ray,
+			const Vector3& normal,
+			const Vector3& hit,
+			const BVH& bvh,
+			const std::vector<std::shared_ptr<Light>>& lights,
+			const float shadow) const;
+
 		float Shadow(const Vector3& hit,
-			const std::vector<std::shared_ptr<Object>>& objects,
+			const BVH& bvh,
 			const std::vector<std::shared_ptr<Light>>& lights) const;
 
 		Vector3 SceneReflections(
@@ -70,9 +86,15 @@ namespace Renderer
 			float roughness,
 			const Size depth,
 			const Size samples,
-			const std::vector<std::shared_ptr<Object>>& objects) const;
+			const BVH& bvh) const;
 
 	private:
+		// Diffuse and specular reflectance towards the viewer of light arriving from lightDirection.
+		Vector3 Reflectance(const Vector3& normal, const Vector3& view, const Vector3& lightDirection, const Vector3& F0) const;
+		// Light reaching hit from an area light, sampling both the light and the reflectance.
+		Vector3 AreaLighting(const Area& light, const Vector3& normal, const Vector3& view, const Vector3& hit, const Vector3& F0, const BVH& bvh) const;
+		// Density per solid angle of reflecting view about a GGX sampled half vector to get direction.
+		float SpecularPdf(const Vector3& normal, const Vector3& view, const Vector3& direction, const float roughness) const;
 		Vector3 Fresnel(const float incidenceAngle, const Vector3& ior) const;
 		float Geometry(const Vector3& normal, const Vector3& view, const Vector3& lightDirection, const float k) const;
 		float Distribution(const Vector3 normal, const Vector3 half, const float roughness) const;
@@ -2,37 +2,29 @@
 
 namespace Renderer
 {
-	class ThreadPool
+	// Persistent pool of worker threads shared by every render. Work is handed out as
+	// parallel for loops, workers claim chunks of iterations with an atomic counter.
+	class ThreadPool : public Singleton<ThreadPool>
 	{
 	public:
-        explicit ThreadPool(
-            const std::function<void(const Size)>& callable,
-            const std::function<void()>& callback = []() {},
-            const Size chunk_size = 10u,
-			const Size threads = static_cast<const Size>(std::thread::hardware_concurrency())) :
-			m_callable(callable),
-			m_callback(callback),
-            m_chunk_size(chunk_size),
-			m_thread_count(threads),
-			m_done(false),
-			m_counter(0)
+		explicit ThreadPool(const Size threads = DefaultThreadCount()) :
+			m_stop(false)
 		{
+			for (Size i = 0; i < threads; ++i)
+			{
+				m_threads.push_back(std::thread(&ThreadPool::Worker, this));
+			}
 		}
 		ThreadPool(const ThreadPool &rhs) = delete;
 		ThreadPool(ThreadPool &&rhs) = delete;
 		ThreadPool& operator=(const ThreadPool& rhs) = delete;
-		~ThreadPool() = default;
-
-		bool operator()(const Size iterations)
+		~ThreadPool()
 		{
-			m_iterations = iterations;
-
-			auto callbackThread = std::thread(&ThreadPool::Callback, this);
-
-			for (Size i = 0; i < m_thread_count - 1; ++i)
 			{
-				m_threads.push_back(std::thread(&ThreadPool::Job, this, 10u));
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
 			}
+			m_conditional.notify_all();
 
 			for (auto& thread : m_threads)
 			{
@@ -41,79 +33,167 @@ namespace Renderer
 					thread.join();
 				}
 			}
+		}
+
+		// Calls callable for every index in [0, iterations) and returns once all of them have
+		// finished. The calling thread helps with the work.
+		void ParallelFor(
+			const std::function<void(const Size)>& callable,
+			const Size iterations,
+			const Size chunk_size = 10u)
+		{
+			if (iterations == 0u)
+			{
+				return;
+			}
+
+			const auto job = Submit(callable, iterations, chunk_size);
+			Execute(*job);
+			Remove(job);
+
+			std::unique_lock<std::mutex> lock(job->Mutex);
+			job->Done.wait(lock, [&]() { return job->Completed == job->Iterations; });
+		}
+
+		// Same as ParallelFor but the calling thread only waits, invoking callback every
+		// interval until the work is complete.
+		void ParallelFor(
+			const std::function<void(const Size)>& callable,
+			const Size iterations,
+			const Size chunk_size,
+			const std::function<void()>& callback,
+			const std::chrono::milliseconds interval)
+		{
+			if (iterations == 0u)
+			{
+				return;
+			}
 
-			callbackThread.join();
+			const auto job = Submit(callable, iterations, chunk_size);
 
-			return true;
+			std::unique_lock<std::mutex> lock(job->Mutex);
+			while (!job->Done.wait_for(lock, interval, [&]() { return job->Completed == job->Iterations; }))
+			{
+				lock.unlock();
+				callback();
+				lock.lock();
+			}
+		}
+
+		Size ThreadCount() const { return m_threads.size(); }
+
+		static Size DefaultThreadCount()
+		{
+			return std::max(static_cast<Size>(std::thread::hardware_concurrency()), static_cast<Size>(1u));
 		}
 
 		static void Run(
-			std::function<void(Size)> callable,
+			const std::function<void(const Size)>& callable,
 			const Size iterations,
-            const Size chunk_size = 10u,
-			const Size threads = static_cast<const Size>(std::thread::hardware_concurrency()))
+            const Size chunk_size = 10u)
 		{
-			ThreadPool pool(callable, []() {}, chunk_size, threads);
-			pool(iterations);
+			GetInstance().ParallelFor(callable, iterations, chunk_size);
 		}
 
 		static void RunWithCallback(
-			std::function<void(Size)> callable,
-			std::function<void()> callback,
+			const std::function<void(const Size)>& callable,
+			const std::function<void()>& callback,
 			const Size iterations,
             const Size chunk_size = 10u,
-			const Size threads = static_cast<const Size>(std::thread::hardware_concurrency()))
+			const std::chrono::milliseconds interval = std::chrono::milliseconds(2000))
 		{
-			ThreadPool pool(callable, callback, chunk_size, threads);
-			pool(iterations);
+			GetInstance().ParallelFor(callable, iterations, chunk_size, callback, interval);
 		}
 
 	private:
-		void Job(const Size amount)
+		struct Job
 		{
-            std::unique_lock<std::mutex> lock(m_mutex);
+			Job(const std::function<void(const Size)>& callable, const Size iterations, const Size chunk_size) :
+				Callable(callable),
+				Iterations(iterations),
+				ChunkSize(chunk_size)
+			{
+			}
 
-			while (!m_done)
+			const std::function<void(const Size)>& Callable;
+			const Size Iterations;
+			const Size ChunkSize;
+			std::atomic_size_t Next = 0u;
+			std::atomic_size_t Completed = 0u;
+			std::mutex Mutex;
+			std::condition_variable Done;
+		};
+
+		std::shared_ptr<Job> Submit(const std::function<void(const Size)>& callable, const Size iterations, const Size chunk_size)
+		{
+			const auto job = std::make_shared<Job>(callable, iterations, std::max(chunk_size, static_cast<Size>(1u)));
 			{
-				const Size start = m_counter;
-				Size end = m_counter + amount;
-				m_counter += amount;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_jobs.push_back(job);
+			}
+			m_conditional.notify_all();
+			return job;
+		}
+
+		void Remove(const std::shared_ptr<Job>& job)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			const auto it = std::find(m_jobs.begin(), m_jobs.end(), job);
+			if (it != m_jobs.end())
+			{
+				m_jobs.erase(it);
+			}
+		}
 
-				if (end > m_iterations)
+		void Execute(Job& job)
+		{
+			while (true)
+			{
+				const Size start = job.Next.fetch_add(job.ChunkSize);
+				if (start >= job.Iterations)
 				{
-					end = m_iterations;
-					m_counter = m_iterations;
-					m_done = true;
+					return;
 				}
 
-                lock.unlock();
-
+				const Size end = std::min(start + job.ChunkSize, job.Iterations);
 				for (Size i = start; i < end; ++i)
 				{
-					m_callable(i);
+					job.Callable(i);
 				}
 
-                lock.lock();
+				if (job.Completed.fetch_add(end - start) + (end - start) == job.Iterations)
+				{
+					std::lock_guard<std::mutex> lock(job.Mutex);
+					job.Done.notify_all();
+				}
 			}
-		};
+		}
 
-		void Callback()
+		void Worker()
 		{
-			while (!m_done)
+			std::unique_lock<std::mutex> lock(m_mutex);
+			while (true)
 			{
-				m_callback();
+				m_conditional.wait(lock, [&]() { return m_stop || !m_jobs.empty(); });
+				if (m_stop)
+				{
+					return;
+				}
+
+				const auto job = m_jobs.front();
+				lock.unlock();
+
+				Execute(*job);
+				Remove(job);
+
+				lock.lock();
 			}
 		}
 
-		const std::function<void(const Size)>& m_callable;
-		const std::function<void()>& m_callback;
-        const Size m_chunk_size;
-		const Size m_thread_count;
-		Size m_iterations;
-
 		std::vector<std::thread> m_threads;
+		std::deque<std::shared_ptr<Job>> m_jobs;
 		std::mutex m_mutex;
-		std::atomic_bool m_done;
-		std::atomic_size_t m_counter;
+		std::condition_variable m_conditional;
+		bool m_stop;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Renderer
+{
+	enum class TileOrder
+	{
+		Scanline,
+		Morton,
+		Hilbert
+	};
+
+	// Rectangular block of pixels, X and Y are the column and row of its top left pixel.
+	struct Tile
+	{
+		Size X = 0u;
+		Size Y = 0u;
+		Size Width = 0u;
+		Size Height = 0u;
+
+		Size Area() const { return Width * Height; }
+	};
+
+	// Splits a columns x rows image into tiles of at most tile_size x tile_size pixels, ordered
+	// along a space filling curve so consecutive tiles are spatially close.
+	std::vector<Tile> CreateTiles(const Size columns, const Size rows, const Size tile_size, const TileOrder order);
+
+	std::uint64_t MortonIndex(const std::uint32_t x, const std::uint32_t y);
+	std::uint64_t HilbertIndex(const std::uint32_t x, const std::uint32_t y, const std::uint32_t n);
+}
\ No newline at end of file
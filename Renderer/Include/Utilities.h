@@ -5,6 +5,8 @@ namespace Renderer
 	using namespace Math;
 
 	class Object;
+	class Instance;
+	class BVH;
 
 	class Transform
 	{
@@ -44,33 +46,68 @@ namespace Renderer
 		void SetPosition(const Vector3& position) { m_position = position; }
 		const Matrix3& GetAxis() const { return m_axis; }
 		const Vector3& GetPosition() const { return m_position; }
-        const Matrix<float>& GetInverse() const { return m_inverse; }
+        const Matrix3& GetInverse() const { return m_inverse; }
 
 	private:
 		Matrix3 m_axis;
 		Vector3 m_position;
-        Matrix<float> m_inverse;
+        Matrix3 m_inverse;
 	};
 
+	// Ray with a normalised direction. The reciprocal and sign of the direction are cached for
+	// slab tests, and objects only report hits within [minDistance, maxDistance].
 	class Ray
 	{
 	public:
-		Ray(Vector3 origin, Vector3 direction) :
+		Ray(Vector3 origin, Vector3 direction, const float minDistance = 0.0f, const float maxDistance = Infinity) :
 			mOrigin(std::move(origin)),
-			mDirection(std::move(direction))
+			mDirection(std::move(direction)),
+			mMinDistance(minDistance),
+			mMaxDistance(maxDistance)
 		{
 			mDirection.Normalize();
+			for (Size i = 0; i < 3; ++i)
+			{
+				mInverseDirection[i] = 1.0f / mDirection[i];
+				mSign[i] = mInverseDirection[i] < 0.0f ? 1u : 0u;
+			}
 		}
 		~Ray() = default;
 
 		const Vector3& GetOrigin() const { return mOrigin; }
 		const Vector3& GetDirection() const { return mDirection; }
+		const Vector3& GetInverseDirection() const { return mInverseDirection; }
+		// 1 on axes the inverse direction is negative along, including -0, slabs are entered through Max on those axes.
+		const std::array<std::uint32_t, 3>& GetSign() const { return mSign; }
+		float GetMinDistance() const { return mMinDistance; }
+		float GetMaxDistance() const { return mMaxDistance; }
+		void SetInterval(const float minDistance, const float maxDistance) { mMinDistance = minDistance; mMaxDistance = maxDistance; }
 		Vector3 Projection(const Vector3& position) const;
 		static Vector3 Reflection(const Vector3& normal, const Vector3& direction);
 
 	private:
 		Vector3 mOrigin;
 		Vector3 mDirection;
+		Vector3 mInverseDirection;
+		std::array<std::uint32_t, 3> mSign;
+		float mMinDistance;
+		float mMaxDistance;
+	};
+
+	struct BoundingBox
+	{
+		Vector3 Min = Vector3(Infinity);
+		Vector3 Max = Vector3(-Infinity);
+
+		void Expand(const Vector3& point);
+		void Expand(const BoundingBox& box);
+		Vector3 Centroid() const;
+		float SurfaceArea() const;
+		Size LongestAxis() const;
+		bool IsValid() const { return Min[0] <= Max[0] && Min[1] <= Max[1] && Min[2] <= Max[2]; }
+
+		// Slab test against the box over [minDistance, maxDistance], distance is where the ray enters.
+		bool Intersect(const Ray& ray, const float minDistance, const float maxDistance, float& distance) const;
 	};
 
 	struct Intersection
@@ -79,9 +116,110 @@ namespace Renderer
 		Vector3 Position = Vector3();
 		Vector3 SurfaceColour = Vector3();
 		const Object* Object = nullptr;
+		// Distance along the ray to Position.
+		float Distance = Infinity;
+		// Set when Object was reached through an instance, Object is then in the instance's space.
+		const Instance* Instance = nullptr;
+		// Which part of Object was hit, for example the triangle of a Mesh.
+		Size Primitive = 0u;
+
+		Vector3 Normal() const;
+	};
+
+	// Result of a closest hit query. Only the distance and object are kept, the position is
+	// rebuilt from the ray when it is needed.
+	struct HitRecord
+	{
+		float Distance = Infinity;
+		const Object* Object = nullptr;
+		const Instance* Instance = nullptr;
+		Size Primitive = 0u;
+
+		explicit operator bool() const { return Object != nullptr; }
+		Vector3 Position(const Ray& ray) const { return ray.GetOrigin() + (ray.GetDirection() * Distance); }
+		Vector3 Normal(const Vector3& position) const;
+	};
+
+	// Up to Width rays traced through the BVH together. Origins, reciprocal directions and
+	// intervals are kept side by side so four rays are tested against a box at once. While all
+	// rays share an origin and direction signs with finite reciprocals the packet is coherent and
+	// the reciprocal bounds give a frustum that culls boxes the whole packet misses in one test.
+	struct RayPacket
+	{
+		static constexpr Size Width = 16u;
+
+		RayPacket() { Rays.reserve(Width); }
+
+		void Push(const Ray& ray);
+		void Clear() { Rays.clear(); Coherent = false; }
+		Size Count() const { return Rays.size(); }
+
+		std::vector<Ray> Rays;
+		alignas(16) std::array<float, Width> OriginX = {};
+		alignas(16) std::array<float, Width> OriginY = {};
+		alignas(16) std::array<float, Width> OriginZ = {};
+		alignas(16) std::array<float, Width> InverseX = {};
+		alignas(16) std::array<float, Width> InverseY = {};
+		alignas(16) std::array<float, Width> InverseZ = {};
+		alignas(16) std::array<float, Width> MinDistance = {};
+		alignas(16) std::array<float, Width> MaxDistance = {};
+		bool Coherent = false;
+		Vector3 MinInverse;
+		Vector3 MaxInverse;
+	};
+
+	// PCG32 generator. Each render thread owns one, reseeded per pixel sample so
+	// renders are reproducible for a given seed regardless of thread scheduling.
+	class RandomGenerator
+	{
+	public:
+		RandomGenerator() { Seed(0u, 0u); }
+		RandomGenerator(const std::uint64_t seed, const std::uint64_t stream) { Seed(seed, stream); }
+
+		void Seed(const std::uint64_t seed, const std::uint64_t stream)
+		{
+			m_state = 0u;
+			m_increment = (Mix(stream) << 1u) | 1u;
+			Next();
+			m_state += Mix(seed);
+			Next();
+		}
+
+		std::uint32_t Next()
+		{
+			const std::uint64_t state = m_state;
+			m_state = state * 6364136223846793005ULL + m_increment;
+			const std::uint32_t shifted = static_cast<std::uint32_t>(((state >> 18u) ^ state) >> 27u);
+			const std::uint32_t rotation = static_cast<std::uint32_t>(state >> 59u);
+			return (shifted >> rotation) | (shifted << ((~rotation + 1u) & 31u));
+		}
+
+		// Uniform float in [0, 1).
+		float NextFloat()
+		{
+			return static_cast<float>(Next() >> 8u) * (1.0f / 16777216.0f);
+		}
+
+	private:
+		// SplitMix64 finaliser so consecutive seeds start far apart in the sequence.
+		static std::uint64_t Mix(std::uint64_t value)
+		{
+			value += 0x9E3779B97F4A7C15ULL;
+			value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27u)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31u);
+		}
+
+		std::uint64_t m_state;
+		std::uint64_t m_increment;
 	};
 
 	std::vector<Intersection> IntersectScene(const std::vector<std::shared_ptr<Object>>& objects, const Ray& ray, bool checkAll);
+	std::vector<Intersection> IntersectScene(const BVH& bvh, const Ray& ray, bool checkAll);
+	HitRecord IntersectClosest(const BVH& bvh, const Ray& ray);
+	bool IsOccluded(const BVH& bvh, const Ray& ray);
+	RandomGenerator& ThreadRandomGenerator();
+	void SeedRandom(const std::uint64_t seed, const std::uint64_t stream);
 	float Random();
 	Vector3 SampleHemisphere(const float r1, const float r2);
 	Vector3 ImportanceSampleHemisphereGGX(const float r1, const float r2, const float roughness);
@@ -29,16 +29,28 @@ namespace Renderer
         template<typename T>
         class Matrix;
 
+        template <typename T, Size SIZE>
+        class SquareMatrix;
+
         template <typename T, Size S>
         class Vector
         {
         public:
-            Vector();
-            Vector(const T value);
-            Vector(const T* data);
-            Vector(std::vector<T> data);
-            Vector(const std::initializer_list<T>& data);
-            virtual ~Vector() {}
+            constexpr Vector() : m_data{} {}
+            constexpr Vector(const T value) : m_data{}
+            {
+                for (Size i = 0; i < S; ++i) { m_data[i] = value; }
+            }
+            constexpr Vector(const T* data) : m_data{}
+            {
+                for (Size i = 0; i < S; ++i) { m_data[i] = data[i]; }
+            }
+            Vector(const std::vector<T>& data);
+            constexpr Vector(const std::initializer_list<T>& data) : m_data{}
+            {
+                Size i = 0;
+                for (auto it = data.begin(); it != data.end() && i < S; ++it, ++i) { m_data[i] = *it; }
+            }
 
             Vector(const Vector &rhs) = default;
             Vector(Vector &&rhs) = default;
@@ -46,63 +58,160 @@ namespace Renderer
             Vector& operator=(Vector&& vector) = default;
 
             // Accessors
-            T& operator[] (Size i) { return m_data[i]; }
-            const T& operator[] (Size i) const { return m_data[i]; }
-            std::vector<T>& Data() { return m_data; }
-            const std::vector<T>& Data() const { return m_data; }
-            Size Count() const { return m_data.size(); }
+            constexpr T& operator[] (Size i) { return m_data[i]; }
+            constexpr const T& operator[] (Size i) const { return m_data[i]; }
+            constexpr std::array<T, S>& Data() { return m_data; }
+            constexpr const std::array<T, S>& Data() const { return m_data; }
+            constexpr Size Count() const { return S; }
 
-            T Length() const;
+            T Length() const { return std::sqrt(DotProduct(*this)); }
             void Normalize();
             Vector Normalized() const;
-            void Clamp(const Size index, const T a, const T b);
-            void Clamp(const T a, const T b);
-            T DotProduct(const Vector& v) const;
-            T Distance(const Vector& v) const;
+            constexpr void Clamp(const Size index, const T a, const T b) { m_data[index] = Renderer::Math::Clamp<T>(m_data[index], a, b); }
+            constexpr void Clamp(const T a, const T b) { for (auto& v : m_data) { v = Renderer::Math::Clamp<T>(v, a, b); } }
+            constexpr T DotProduct(const Vector& v) const;
+            T Distance(const Vector& v) const { return (v - *this).Length(); }
             void SetNaNsOrINFs(const T value, const bool setNaNs = true, bool setINFs = true);
             void Pow(const T exponent);
 
-            static Vector Mix(const Vector& a, const Vector& b, const T &amount);
-            static Vector Min(const Vector& a, const Vector& b);
-            static Vector Max(const Vector& a, const Vector& b);
+            static constexpr Vector Mix(const Vector& a, const Vector& b, const T &amount);
+            static constexpr Vector Min(const Vector& a, const Vector& b);
+            static constexpr Vector Max(const Vector& a, const Vector& b);
 
             // Size dependant functions.
             Vector MatrixMultiply(const Matrix<T>& matrix) const;
-            Vector CrossProduct(const Vector& other) const;
+            constexpr Vector MatrixMultiply(const SquareMatrix<T, S>& matrix) const;
+            constexpr Vector CrossProduct(const Vector& other) const;
 
             // Operators
-            Vector operator* (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(*) }
-            Vector operator+ (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(+) }
-            Vector operator- (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(-) }
-            Vector operator/ (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(/ ) }
+            constexpr Vector operator* (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(*) }
+            constexpr Vector operator+ (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(+) }
+            constexpr Vector operator- (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(-) }
+            constexpr Vector operator/ (const Vector& rhs) const { CUSTOM_OPERATOR_VECTOR(/ ) }
             
-            Vector& operator*= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(*) }
-            Vector& operator+= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(+) }
-            Vector& operator-= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(-) }
-            Vector& operator/= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(/ ) }
+            constexpr Vector& operator*= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(*) }
+            constexpr Vector& operator+= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(+) }
+            constexpr Vector& operator-= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(-) }
+            constexpr Vector& operator/= (const Vector& rhs) { CUSTOM_OPERATOR_VECTOR_EQUALS(/ ) }
             
-            Vector operator* (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(*) }
-            Vector operator+ (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(+) }
-            Vector operator- (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(-) }
-            Vector operator/ (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(/ ) }
+            constexpr Vector operator* (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(*) }
+            constexpr Vector operator+ (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(+) }
+            constexpr Vector operator- (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(-) }
+            constexpr Vector operator/ (const T& rhs) const { CUSTOM_OPERATOR_VECTOR_T(/ ) }
             
-            Vector& operator*= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(*) }
-            Vector& operator+= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(+) }
-            Vector& operator-= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(-) }
-            Vector& operator/= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(/ ) }
+            constexpr Vector& operator*= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(*) }
+            constexpr Vector& operator+= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(+) }
+            constexpr Vector& operator-= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(-) }
+            constexpr Vector& operator/= (const T& rhs) { CUSTOM_OPERATOR_VECTOR_T_EQUALS(/ ) }
 
         protected:
-            std::vector<T> m_data;
+            std::array<T, S> m_data;
         };
 
+        template<typename T, Size S>
+        void Vector<T, S>::Normalize()
+        {
+            const T length = Length();
+            for (auto& value : m_data)
+            {
+                value /= length;
+            }
+        }
+
+        template<typename T, Size S>
+        Vector<T, S> Vector<T, S>::Normalized() const
+        {
+            auto normalized = *this;
+            normalized.Normalize();
+            return normalized;
+        }
+
+        template<typename T, Size S>
+        constexpr T Vector<T, S>::DotProduct(const Vector<T, S>& v) const
+        {
+            T sum = static_cast<T>(0);
+            for (Size i = 0; i < S; ++i)
+            {
+                sum += m_data[i] * v[i];
+            }
+            return sum;
+        }
+
+        template<typename T, Size S>
+        constexpr Vector<T, S> Vector<T, S>::Mix(const Vector<T, S>& a, const Vector<T, S>& b, const T &amount)
+        {
+            Vector<T, S> result;
+            for (Size i = 0; i < S; ++i)
+            {
+                result[i] = Math::Mix<T>(a[i], b[i], amount);
+            }
+            return result;
+        }
+
+        template<typename T, Size S>
+        constexpr Vector<T, S> Vector<T, S>::Min(const Vector<T, S>& a, const Vector<T, S>& b)
+        {
+            Vector<T, S> result;
+            for (Size i = 0; i < S; ++i)
+            {
+                result[i] = std::min(a[i], b[i]);
+            }
+            return result;
+        }
+
+        template<typename T, Size S>
+        constexpr Vector<T, S> Vector<T, S>::Max(const Vector<T, S>& a, const Vector<T, S>& b)
+        {
+            Vector<T, S> result;
+            for (Size i = 0; i < S; ++i)
+            {
+                result[i] = std::max(a[i], b[i]);
+            }
+            return result;
+        }
+
+        template<typename T, Size S>
+        constexpr Vector<T, S> Vector<T, S>::MatrixMultiply(const SquareMatrix<T, S>& matrix) const
+        {
+            Vector<T, S> result;
+            for (Size r = 0; r < S; ++r)
+            {
+                T sum = static_cast<T>(0);
+                for (Size c = 0; c < S; ++c)
+                {
+                    sum += matrix[(S * r) + c] * m_data[c];
+                }
+                result[r] = sum;
+            }
+            return result;
+        }
+
+        template<typename T, Size S>
+        constexpr Vector<T, S> Vector<T, S>::CrossProduct(const Vector<T, S>& other) const
+        {
+            if (S != 3)
+            {
+                throw std::logic_error("Vector must be 3 dimensional.");
+            }
+
+            Vector<T, S> result;
+            result[0] = m_data[1] * other[2] - m_data[2] * other[1];
+            result[1] = m_data[2] * other[0] - m_data[0] * other[2];
+            result[2] = m_data[0] * other[1] - m_data[1] * other[0];
+            return result;
+        }
+
         using Vector2 = Vector<float, 2>;
         using Vector3 = Vector<float, 3>;
 
-        const Vector3 X_AXIS = { 1.0, 0.0, 0.0 };
-        const Vector3 Y_AXIS = { 0.0, 1.0, 0.0 };
-        const Vector3 Z_AXIS = { 0.0, 0.0, 1.0 };
-        const Vector3 X_MINUS_AXIS = { -1.0, 0.0, 0.0 };
-        const Vector3 Y_MINUS_AXIS = { 0.0, -1.0, 0.0 };
-        const Vector3 Z_MINUS_AXIS = { 0.0, 0.0, -1.0 };
+        static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 must stay trivially copyable.");
+        static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must not carry any extra storage.");
+
+        constexpr Vector3 X_AXIS = { 1.0f, 0.0f, 0.0f };
+        constexpr Vector3 Y_AXIS = { 0.0f, 1.0f, 0.0f };
+        constexpr Vector3 Z_AXIS = { 0.0f, 0.0f, 1.0f };
+        constexpr Vector3 X_MINUS_AXIS = { -1.0f, 0.0f, 0.0f };
+        constexpr Vector3 Y_MINUS_AXIS = { 0.0f, -1.0f, 0.0f };
+        constexpr Vector3 Z_MINUS_AXIS = { 0.0f, 0.0f, -1.0f };
     }
 }
\ No newline at end of file
@@ -11,12 +11,17 @@ namespace Renderer
 
         void SetAspectRatio(const float a, const float b);
         void SetPixel(const Size index, const float r, const float g, const float b);
+        // Writes a tile worth of colours, stored row by row, into the image.
+        void SetTile(const Tile& tile, const std::vector<Vector3>& colours);
 
         Vector3 GetPixelValue(const Size index) const;
         Vector2 GetPixelUV(const Size index) const;
         Vector3 GetPixelPosition(const float u, const float v) const;
         const Pixels& GetPixels() const { return m_pixels; }
         Size Area() const { return m_pixels[0].Area(); }
+        Size Columns() const { return m_pixels[0].Columns(); }
+        Size Rows() const { return m_pixels[0].Rows(); }
+        Size Index(const Size column, const Size row) const { return (row * Columns()) + column; }
 
     private:
         void Initialize();
@@ -0,0 +1,814 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+using namespace Renderer::Math;
+
+namespace
+{
+    // Keeps the traversal stack bounded, nodes deeper than this become leaves.
+    constexpr Size MaxDepth = 60u;
+    constexpr Size StackSize = 64u;
+    // Each wide node pops one entry and pushes at most three more than it removes.
+    constexpr Size WideStackSize = (MaxDepth * (BVH::WideNode::Width - 1u)) + 4u;
+
+    // True if the box misses every ray of a coherent packet. All rays share an origin and
+    // direction signs, so bounding the reciprocal directions bounds where any of them can enter
+    // and leave the box without testing the rays one by one.
+    bool FrustumMisses(const BoundingBox& box, const RayPacket& packet, const float minDistance, const float maxDistance)
+    {
+        const auto& origin = packet.Rays.front().GetOrigin();
+        const auto& sign = packet.Rays.front().GetSign();
+
+        float enter = minDistance;
+        float leave = maxDistance;
+        for (Size axis = 0; axis < 3; ++axis)
+        {
+            const float entry = (sign[axis] != 0u ? box.Max[axis] : box.Min[axis]) - origin[axis];
+            const float exit = (sign[axis] != 0u ? box.Min[axis] : box.Max[axis]) - origin[axis];
+            enter = std::max(enter, std::min(entry * packet.MinInverse[axis], entry * packet.MaxInverse[axis]));
+            leave = std::min(leave, std::max(exit * packet.MinInverse[axis], exit * packet.MaxInverse[axis]));
+        }
+        return enter > leave;
+    }
+
+    // Slab test of the box against the rays in active, returns the rays that hit it within
+    // their interval. maxDistances holds the current closest hit of every ray.
+    std::uint32_t PacketHits(const BoundingBox& box, const RayPacket& packet, const std::array<float, RayPacket::Width>& maxDistances, const std::uint32_t active)
+    {
+        std::uint32_t hits = 0u;
+#ifdef RENDERER_SSE
+        const __m128 minX = _mm_set1_ps(box.Min[0]);
+        const __m128 minY = _mm_set1_ps(box.Min[1]);
+        const __m128 minZ = _mm_set1_ps(box.Min[2]);
+        const __m128 maxX = _mm_set1_ps(box.Max[0]);
+        const __m128 maxY = _mm_set1_ps(box.Max[1]);
+        const __m128 maxZ = _mm_set1_ps(box.Max[2]);
+
+        for (Size i = 0; i < RayPacket::Width; i += 4u)
+        {
+            if (((active >> i) & 0xFu) == 0u)
+            {
+                continue;
+            }
+
+            const __m128 originX = _mm_load_ps(&packet.OriginX[i]);
+            const __m128 originY = _mm_load_ps(&packet.OriginY[i]);
+            const __m128 originZ = _mm_load_ps(&packet.OriginZ[i]);
+            const __m128 inverseX = _mm_load_ps(&packet.InverseX[i]);
+            const __m128 inverseY = _mm_load_ps(&packet.InverseY[i]);
+            const __m128 inverseZ = _mm_load_ps(&packet.InverseZ[i]);
+
+            const __m128 x1 = _mm_mul_ps(_mm_sub_ps(minX, originX), inverseX);
+            const __m128 x2 = _mm_mul_ps(_mm_sub_ps(maxX, originX), inverseX);
+            const __m128 y1 = _mm_mul_ps(_mm_sub_ps(minY, originY), inverseY);
+            const __m128 y2 = _mm_mul_ps(_mm_sub_ps(maxY, originY), inverseY);
+            const __m128 z1 = _mm_mul_ps(_mm_sub_ps(minZ, originZ), inverseZ);
+            const __m128 z2 = _mm_mul_ps(_mm_sub_ps(maxZ, originZ), inverseZ);
+
+            const __m128 tmin = _mm_max_ps(
+                _mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)),
+                _mm_max_ps(_mm_min_ps(z1, z2), _mm_load_ps(&packet.MinDistance[i])));
+            const __m128 tmax = _mm_min_ps(
+                _mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)),
+                _mm_min_ps(_mm_max_ps(z1, z2), _mm_load_ps(&maxDistances[i])));
+
+            hits |= static_cast<std::uint32_t>(_mm_movemask_ps(_mm_cmple_ps(tmin, tmax))) << i;
+        }
+#else
+        for (Size i = 0; i < RayPacket::Width; ++i)
+        {
+            if ((active & (1u << i)) == 0u)
+            {
+                continue;
+            }
+
+            const float x1 = (box.Min[0] - packet.OriginX[i]) * packet.InverseX[i];
+            const float x2 = (box.Max[0] - packet.OriginX[i]) * packet.InverseX[i];
+            const float y1 = (box.Min[1] - packet.OriginY[i]) * packet.InverseY[i];
+            const float y2 = (box.Max[1] - packet.OriginY[i]) * packet.InverseY[i];
+            const float z1 = (box.Min[2] - packet.OriginZ[i]) * packet.InverseZ[i];
+            const float z2 = (box.Max[2] - packet.OriginZ[i]) * packet.InverseZ[i];
+            const float tmin = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), packet.MinDistance[i]));
+            const float tmax = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), maxDistances[i]));
+            hits |= tmin <= tmax ? (1u << i) : 0u;
+        }
+#endif
+        return hits & active;
+    }
+}
+
+BVH::BVH(const std::vector<std::shared_ptr<Object>>& objects) :
+    BVH(objects, Settings())
+{
+}
+
+BVH::BVH(const std::vector<std::shared_ptr<Object>>& objects, const Settings& settings) :
+    m_settings(settings)
+{
+    Build(objects);
+}
+
+void BVH::Build(const std::vector<std::shared_ptr<Object>>& objects)
+{
+    m_nodes.clear();
+    m_wideNodes.clear();
+    m_objects.clear();
+    m_primitives.Clear();
+
+    if (objects.empty())
+    {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Primitive> primitives(objects.size());
+    ThreadPool::Run([&](const Size i)
+    {
+        const auto bounds = objects[i]->Bounds();
+        primitives[i] = { bounds, bounds.Centroid(), i };
+    }, objects.size(), 256u);
+
+    const auto root = BuildBinned(primitives, 0u, primitives.size(), 0u);
+
+    Size leaves = 0u;
+    Size depth = 0u;
+    m_nodes.reserve(2u * objects.size());
+    Flatten(*root, 0u, leaves, depth);
+
+    // Store the objects in leaf order so each leaf references a contiguous range, with the
+    // objects of a leaf grouped by type so the store tests them in batches.
+    for (const auto& node : m_nodes)
+    {
+        if (node.IsLeaf())
+        {
+            const auto first = primitives.begin() + static_cast<std::ptrdiff_t>(node.Offset);
+            std::stable_sort(first, first + static_cast<std::ptrdiff_t>(node.Count), [&](const Primitive& a, const Primitive& b)
+            {
+                return PrimitiveStore::Classify(*objects[a.Index]) < PrimitiveStore::Classify(*objects[b.Index]);
+            });
+        }
+    }
+
+    m_objects.reserve(objects.size());
+    for (const auto& primitive : primitives)
+    {
+        m_objects.push_back(objects[primitive.Index]);
+    }
+    m_primitives.Build(m_objects);
+
+    if (m_settings.NodeLayout == Layout::Wide)
+    {
+        m_wideNodes.reserve(m_nodes.size() / 2u + 1u);
+        Collapse(0u);
+    }
+    m_buildCost = Cost();
+
+    const auto end = std::chrono::steady_clock::now();
+    LOG_INFO("BVH built in ", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), "ms. Objects: ", objects.size(),
+        ", nodes: ", m_nodes.size(), ", wide nodes: ", m_wideNodes.size(), ", leaves: ", leaves, ", depth: ", depth);
+}
+
+bool BVH::Refit()
+{
+    if (m_nodes.empty())
+    {
+        return false;
+    }
+
+    m_primitives.Update(m_objects);
+    return RefitNodes();
+}
+
+bool BVH::Commit()
+{
+    if (m_nodes.empty() || !m_primitives.Update(m_objects))
+    {
+        return false;
+    }
+
+    RefitNodes();
+    return true;
+}
+
+bool BVH::RefitNodes()
+{
+    // Children are always stored after their parent so a reverse sweep visits them first.
+    for (Size index = m_nodes.size(); index > 0u; --index)
+    {
+        Node& node = m_nodes[index - 1u];
+        BoundingBox bounds;
+        if (node.IsLeaf())
+        {
+            for (Size i = node.Offset; i < node.Offset + node.Count; ++i)
+            {
+                bounds.Expand(m_primitives.GetBounds(i));
+            }
+        }
+        else
+        {
+            bounds.Expand(m_nodes[index].Bounds);
+            bounds.Expand(m_nodes[node.Offset].Bounds);
+        }
+        node.Bounds = bounds;
+    }
+
+    if (m_settings.RebuildRatio > 0.0f && Cost() > m_buildCost * m_settings.RebuildRatio)
+    {
+        const auto objects = m_objects;
+        Build(objects);
+        return true;
+    }
+
+    if (!m_wideNodes.empty())
+    {
+        m_wideNodes.clear();
+        Collapse(0u);
+    }
+    return false;
+}
+
+float BVH::Cost() const
+{
+    if (m_nodes.empty())
+    {
+        return 0.0f;
+    }
+
+    float cost = 0.0f;
+    for (const auto& node : m_nodes)
+    {
+        const float area = node.Bounds.SurfaceArea();
+        cost += node.IsLeaf() ?
+            m_settings.IntersectionCost * static_cast<float>(node.Count) * area :
+            m_settings.TraversalCost * area;
+    }
+    return cost / std::max(m_nodes.front().Bounds.SurfaceArea(), std::numeric_limits<float>::min());
+}
+
+Size BVH::Collapse(const Size index)
+{
+    const Size wideIndex = m_wideNodes.size();
+    m_wideNodes.emplace_back();
+
+    std::vector<Size> children;
+    if (m_nodes[index].IsLeaf())
+    {
+        children.push_back(index);
+    }
+    else
+    {
+        children.push_back(index + 1u);
+        children.push_back(m_nodes[index].Offset);
+    }
+
+    // Open the interior child with the largest surface area until the node is full.
+    while (children.size() < WideNode::Width)
+    {
+        Size largest = children.size();
+        float largestArea = -1.0f;
+        for (Size i = 0; i < children.size(); ++i)
+        {
+            const Node& child = m_nodes[children[i]];
+            if (!child.IsLeaf() && child.Bounds.SurfaceArea() > largestArea)
+            {
+                largest = i;
+                largestArea = child.Bounds.SurfaceArea();
+            }
+        }
+
+        if (largest == children.size())
+        {
+            break;
+        }
+
+        const Size opened = children[largest];
+        children[largest] = opened + 1u;
+        children.push_back(m_nodes[opened].Offset);
+    }
+
+    std::array<std::uint32_t, WideNode::Width> offsets = {};
+    std::array<std::uint32_t, WideNode::Width> counts = {};
+    for (Size i = 0; i < children.size(); ++i)
+    {
+        const Node& child = m_nodes[children[i]];
+        if (child.IsLeaf())
+        {
+            offsets[i] = static_cast<std::uint32_t>(child.Offset);
+            counts[i] = static_cast<std::uint32_t>(child.Count);
+        }
+        else
+        {
+            offsets[i] = static_cast<std::uint32_t>(Collapse(children[i]));
+        }
+    }
+
+    // Collapse appends to m_wideNodes so only take the reference once the children exist.
+    WideNode& node = m_wideNodes[wideIndex];
+    node.Children = children.size();
+    node.Offset = offsets;
+    node.Count = counts;
+    for (Size i = 0; i < WideNode::Width; ++i)
+    {
+        const BoundingBox bounds = i < children.size() ? m_nodes[children[i]].Bounds : BoundingBox();
+        node.MinX[i] = bounds.Min[0];
+        node.MinY[i] = bounds.Min[1];
+        node.MinZ[i] = bounds.Min[2];
+        node.MaxX[i] = bounds.Max[0];
+        node.MaxY[i] = bounds.Max[1];
+        node.MaxZ[i] = bounds.Max[2];
+    }
+    return wideIndex;
+}
+
+void BVH::BinPrimitives(const std::vector<Primitive>& primitives, const Size start, const Size end, const BoundingBox& centroids, std::vector<Bin>& bins) const
+{
+    const Size binCount = bins.size() / 3u;
+    const auto binRange = [&](const Size first, const Size last, std::vector<Bin>& result)
+    {
+        for (Size axis = 0; axis < 3; ++axis)
+        {
+            const float extent = centroids.Max[axis] - centroids.Min[axis];
+            if (extent <= 0.0f)
+            {
+                continue;
+            }
+
+            const float scale = static_cast<float>(binCount) / extent;
+            for (Size i = first; i < last; ++i)
+            {
+                const auto offset = static_cast<Size>((primitives[i].Centroid[axis] - centroids.Min[axis]) * scale);
+                Bin& bin = result[(axis * binCount) + std::min(offset, binCount - 1u)];
+                bin.Bounds.Expand(primitives[i].Bounds);
+                ++bin.Count;
+            }
+        }
+    };
+
+    const Size count = end - start;
+    if (count < m_settings.ParallelThreshold)
+    {
+        binRange(start, end, bins);
+        return;
+    }
+
+    // Large ranges are binned in chunks on the pool and the partial bins merged afterwards.
+    const Size chunkSize = std::max(m_settings.ParallelThreshold / 4u, static_cast<Size>(1u));
+    const Size chunks = (count + chunkSize - 1u) / chunkSize;
+    std::vector<std::vector<Bin>> partial(chunks, std::vector<Bin>(bins.size()));
+    ThreadPool::Run([&](const Size chunk)
+    {
+        const Size first = start + (chunk * chunkSize);
+        binRange(first, std::min(first + chunkSize, end), partial[chunk]);
+    }, chunks, 1u);
+
+    for (const auto& chunk : partial)
+    {
+        for (Size i = 0; i < bins.size(); ++i)
+        {
+            bins[i].Bounds.Expand(chunk[i].Bounds);
+            bins[i].Count += chunk[i].Count;
+        }
+    }
+}
+
+std::unique_ptr<BVH::BuildNode> BVH::BuildBinned(std::vector<Primitive>& primitives, const Size start, const Size end, const Size depth) const
+{
+    auto node = std::make_unique<BuildNode>();
+    node->Start = start;
+
+    BoundingBox centroids;
+    for (Size i = start; i < end; ++i)
+    {
+        node->Bounds.Expand(primitives[i].Bounds);
+        centroids.Expand(primitives[i].Centroid);
+    }
+
+    const Size count = end - start;
+    const auto makeLeaf = [&]()
+    {
+        node->Count = count;
+        return std::move(node);
+    };
+
+    if (count == 1u || depth >= MaxDepth)
+    {
+        return makeLeaf();
+    }
+
+    // Surface area heuristic evaluated at the boundaries between centroid bins on each axis.
+    const Size binCount = std::max(m_settings.Bins, static_cast<Size>(2u));
+    std::vector<Bin> bins(3u * binCount);
+    BinPrimitives(primitives, start, end, centroids, bins);
+
+    const float inverseArea = 1.0f / std::max(node->Bounds.SurfaceArea(), std::numeric_limits<float>::min());
+    float bestCost = Infinity;
+    Size bestAxis = 0u;
+    Size bestSplit = 0u;
+    std::vector<float> rightAreas(binCount);
+    std::vector<Size> rightCounts(binCount);
+    for (Size axis = 0; axis < 3; ++axis)
+    {
+        if (centroids.Max[axis] - centroids.Min[axis] <= 0.0f)
+        {
+            continue;
+        }
+
+        const Bin* axisBins = &bins[axis * binCount];
+        BoundingBox right;
+        Size rightCount = 0u;
+        for (Size i = binCount - 1u; i > 0; --i)
+        {
+            right.Expand(axisBins[i].Bounds);
+            rightCount += axisBins[i].Count;
+            rightAreas[i] = right.SurfaceArea();
+            rightCounts[i] = rightCount;
+        }
+
+        BoundingBox left;
+        Size leftCount = 0u;
+        for (Size i = 1; i < binCount; ++i)
+        {
+            left.Expand(axisBins[i - 1u].Bounds);
+            leftCount += axisBins[i - 1u].Count;
+            if (leftCount == 0u || rightCounts[i] == 0u)
+            {
+                continue;
+            }
+
+            const float cost = m_settings.TraversalCost + m_settings.IntersectionCost * inverseArea *
+                ((left.SurfaceArea() * static_cast<float>(leftCount)) + (rightAreas[i] * static_cast<float>(rightCounts[i])));
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    Size mid = start + (count / 2u);
+    if (bestSplit == 0u)
+    {
+        // Every centroid is in the same place, splitting cannot separate them.
+        if (count <= m_settings.MaxLeafSize)
+        {
+            return makeLeaf();
+        }
+    }
+    else
+    {
+        const float leafCost = m_settings.IntersectionCost * static_cast<float>(count);
+        if (count <= m_settings.MaxLeafSize && bestCost >= leafCost)
+        {
+            return makeLeaf();
+        }
+
+        const float minimum = centroids.Min[bestAxis];
+        const float scale = static_cast<float>(binCount) / (centroids.Max[bestAxis] - minimum);
+        const auto split = std::partition(primitives.begin() + start, primitives.begin() + end, [&](const Primitive& primitive)
+        {
+            return std::min(static_cast<Size>((primitive.Centroid[bestAxis] - minimum) * scale), binCount - 1u) < bestSplit;
+        });
+        mid = static_cast<Size>(split - primitives.begin());
+    }
+    node->Axis = bestAxis;
+
+    if (count >= m_settings.ParallelThreshold)
+    {
+        ThreadPool::Run([&](const Size i)
+        {
+            node->Children[i] = i == 0u ?
+                BuildBinned(primitives, start, mid, depth + 1u) :
+                BuildBinned(primitives, mid, end, depth + 1u);
+        }, 2u, 1u);
+    }
+    else
+    {
+        node->Children[0] = BuildBinned(primitives, start, mid, depth + 1u);
+        node->Children[1] = BuildBinned(primitives, mid, end, depth + 1u);
+    }
+    return node;
+}
+
+void BVH::Flatten(const BuildNode& node, const Size depth, Size& leaves, Size& maxDepth)
+{
+    const Size index = m_nodes.size();
+    m_nodes.emplace_back();
+    m_nodes[index].Bounds = node.Bounds;
+    maxDepth = std::max(maxDepth, depth);
+
+    if (node.Count > 0u)
+    {
+        m_nodes[index].Offset = node.Start;
+        m_nodes[index].Count = node.Count;
+        ++leaves;
+        return;
+    }
+
+    // The first child directly follows its parent, the parent records where the second starts.
+    Flatten(*node.Children[0], depth + 1u, leaves, maxDepth);
+    m_nodes[index].Offset = m_nodes.size();
+    m_nodes[index].Axis = node.Axis;
+    Flatten(*node.Children[1], depth + 1u, leaves, maxDepth);
+}
+
+template <typename Visitor>
+void BVH::Traverse(const Ray& ray, const float minDistance, const float& maxDistance, Visitor&& visit) const
+{
+    if (m_nodes.empty())
+    {
+        return;
+    }
+
+    if (!m_wideNodes.empty())
+    {
+        TraverseWide(ray, minDistance, maxDistance, visit);
+        return;
+    }
+
+    const auto& sign = ray.GetSign();
+
+    std::array<Size, StackSize> stack;
+    Size stackSize = 0u;
+    stack[stackSize++] = 0u;
+
+    while (stackSize > 0u)
+    {
+        const Size index = stack[--stackSize];
+        const Node& node = m_nodes[index];
+
+        float distance = 0.0f;
+        if (!node.Bounds.Intersect(ray, minDistance, maxDistance, distance))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            if (!visit(node.Offset, node.Count))
+            {
+                return;
+            }
+            continue;
+        }
+
+        // Visit the child nearest along the split axis first so the far one is culled more often.
+        if (sign[node.Axis] != 0u)
+        {
+            stack[stackSize++] = index + 1u;
+            stack[stackSize++] = node.Offset;
+        }
+        else
+        {
+            stack[stackSize++] = node.Offset;
+            stack[stackSize++] = index + 1u;
+        }
+    }
+}
+
+template <typename Visitor>
+void BVH::TraverseWide(const Ray& ray, const float minDistance, const float& maxDistance, Visitor&& visit) const
+{
+    const auto& origin = ray.GetOrigin();
+    const auto& inverseDirection = ray.GetInverseDirection();
+
+#ifdef RENDERER_SSE
+    const __m128 originX = _mm_set1_ps(origin[0]);
+    const __m128 originY = _mm_set1_ps(origin[1]);
+    const __m128 originZ = _mm_set1_ps(origin[2]);
+    const __m128 inverseX = _mm_set1_ps(inverseDirection[0]);
+    const __m128 inverseY = _mm_set1_ps(inverseDirection[1]);
+    const __m128 inverseZ = _mm_set1_ps(inverseDirection[2]);
+    const __m128 minimum = _mm_set1_ps(minDistance);
+#endif
+
+    std::array<std::uint32_t, WideStackSize> stack;
+    Size stackSize = 0u;
+    stack[stackSize++] = 0u;
+
+    while (stackSize > 0u)
+    {
+        const WideNode& node = m_wideNodes[stack[--stackSize]];
+
+        alignas(16) std::array<float, WideNode::Width> distances;
+        int mask = 0;
+#ifdef RENDERER_SSE
+        const __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MinX.data()), originX), inverseX);
+        const __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MaxX.data()), originX), inverseX);
+        const __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MinY.data()), originY), inverseY);
+        const __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MaxY.data()), originY), inverseY);
+        const __m128 z1 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MinZ.data()), originZ), inverseZ);
+        const __m128 z2 = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(node.MaxZ.data()), originZ), inverseZ);
+
+        const __m128 tmin = _mm_max_ps(
+            _mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)),
+            _mm_max_ps(_mm_min_ps(z1, z2), minimum));
+        const __m128 tmax = _mm_min_ps(
+            _mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2)),
+            _mm_min_ps(_mm_max_ps(z1, z2), _mm_set1_ps(maxDistance)));
+
+        _mm_store_ps(distances.data(), tmin);
+        mask = _mm_movemask_ps(_mm_cmple_ps(tmin, tmax));
+#else
+        for (Size i = 0; i < WideNode::Width; ++i)
+        {
+            const float x1 = (node.MinX[i] - origin[0]) * inverseDirection[0];
+            const float x2 = (node.MaxX[i] - origin[0]) * inverseDirection[0];
+            const float y1 = (node.MinY[i] - origin[1]) * inverseDirection[1];
+            const float y2 = (node.MaxY[i] - origin[1]) * inverseDirection[1];
+            const float z1 = (node.MinZ[i] - origin[2]) * inverseDirection[2];
+            const float z2 = (node.MaxZ[i] - origin[2]) * inverseDirection[2];
+            const float tmin = std::max(std::max(std::min(x1, x2), std::min(y1, y2)), std::max(std::min(z1, z2), minDistance));
+            const float tmax = std::min(std::min(std::max(x1, x2), std::max(y1, y2)), std::min(std::max(z1, z2), maxDistance));
+            distances[i] = tmin;
+            mask |= tmin <= tmax ? (1 << i) : 0;
+        }
+#endif
+        mask &= (1 << node.Children) - 1;
+
+        // Order the children that were hit from near to far.
+        std::array<Size, WideNode::Width> order;
+        Size hits = 0u;
+        for (Size i = 0; i < WideNode::Width; ++i)
+        {
+            if ((mask & (1 << i)) == 0)
+            {
+                continue;
+            }
+
+            Size j = hits++;
+            for (; j > 0u && distances[order[j - 1u]] > distances[i]; --j)
+            {
+                order[j] = order[j - 1u];
+            }
+            order[j] = i;
+        }
+
+        // Leaves are visited straight away, interior children are pushed far first so the
+        // nearest is popped next.
+        for (Size i = 0; i < hits; ++i)
+        {
+            const Size child = order[i];
+            if (node.Count[child] == 0u || distances[child] > maxDistance)
+            {
+                continue;
+            }
+
+            if (!visit(node.Offset[child], node.Count[child]))
+            {
+                return;
+            }
+        }
+
+        for (Size i = hits; i > 0u; --i)
+        {
+            const Size child = order[i - 1u];
+            if (node.Count[child] == 0u)
+            {
+                stack[stackSize++] = node.Offset[child];
+            }
+        }
+    }
+}
+
+Intersection BVH::Intersect(const Ray& ray, const bool checkAll) const
+{
+    Intersection closest;
+    float closestDistance = Infinity;
+    Traverse(ray, 0.0f, closestDistance, [&](const Size start, const Size count) -> bool
+    {
+        for (Size i = start; i < start + count; ++i)
+        {
+            const Intersection intersection = m_objects[i]->Intersect(ray);
+            if (!intersection.Hit)
+            {
+                continue;
+            }
+
+            if (!checkAll)
+            {
+                closest = intersection;
+                return false;
+            }
+
+            if (intersection.Distance < closestDistance)
+            {
+                closestDistance = intersection.Distance;
+                closest = intersection;
+            }
+        }
+        return true;
+    });
+    return closest;
+}
+
+HitRecord BVH::Closest(const Ray& ray) const
+{
+    HitRecord closest;
+    closest.Distance = ray.GetMaxDistance();
+    Traverse(ray, ray.GetMinDistance(), closest.Distance, [&](const Size start, const Size count) -> bool
+    {
+        m_primitives.Closest(ray, start, count, closest);
+        return true;
+    });
+
+    if (!closest)
+    {
+        closest.Distance = Infinity;
+    }
+    return closest;
+}
+
+bool BVH::Occluded(const Ray& ray) const
+{
+    bool occluded = false;
+    Traverse(ray, ray.GetMinDistance(), ray.GetMaxDistance(), [&](const Size start, const Size count) -> bool
+    {
+        occluded = m_primitives.Occluded(ray, start, count);
+        return !occluded;
+    });
+    return occluded;
+}
+
+void BVH::Closest(const RayPacket& packet, std::array<HitRecord, RayPacket::Width>& closest) const
+{
+    const Size count = packet.Count();
+    alignas(16) std::array<float, RayPacket::Width> maxDistances;
+    float minDistance = Infinity;
+    float maxDistance = -Infinity;
+    for (Size i = 0; i < RayPacket::Width; ++i)
+    {
+        closest[i] = HitRecord();
+        closest[i].Distance = i < count ? packet.MaxDistance[i] : -Infinity;
+        maxDistances[i] = closest[i].Distance;
+        minDistance = i < count ? std::min(minDistance, packet.MinDistance[i]) : minDistance;
+        maxDistance = std::max(maxDistance, maxDistances[i]);
+    }
+
+    // Each entry keeps the rays that entered the parent, children only test those.
+    std::array<std::pair<Size, std::uint32_t>, StackSize> stack;
+    Size stackSize = 0u;
+    if (!m_nodes.empty() && count > 0u)
+    {
+        stack[stackSize++] = { 0u, (1u << count) - 1u };
+    }
+
+    while (stackSize > 0u)
+    {
+        const auto [index, parentActive] = stack[--stackSize];
+        const Node& node = m_nodes[index];
+
+        if (packet.Coherent && FrustumMisses(node.Bounds, packet, minDistance, maxDistance))
+        {
+            continue;
+        }
+
+        const std::uint32_t active = PacketHits(node.Bounds, packet, maxDistances, parentActive);
+        if (active == 0u)
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            maxDistance = -Infinity;
+            for (Size i = 0; i < count; ++i)
+            {
+                if ((active & (1u << i)) != 0u)
+                {
+                    m_primitives.Closest(packet.Rays[i], node.Offset, node.Count, closest[i]);
+                    maxDistances[i] = closest[i].Distance;
+                }
+                maxDistance = std::max(maxDistance, maxDistances[i]);
+            }
+            continue;
+        }
+
+        // Near child first for the first active ray, in a coherent packet every ray agrees.
+        Size first = 0u;
+        while ((active & (1u << first)) == 0u)
+        {
+            ++first;
+        }
+
+        if (packet.Rays[first].GetSign()[node.Axis] != 0u)
+        {
+            stack[stackSize++] = { index + 1u, active };
+            stack[stackSize++] = { node.Offset, active };
+        }
+        else
+        {
+            stack[stackSize++] = { node.Offset, active };
+            stack[stackSize++] = { index + 1u, active };
+        }
+    }
+
+    for (Size i = 0; i < RayPacket::Width; ++i)
+    {
+        if (!closest[i])
+        {
+            closest[i].Distance = Infinity;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,895 @@
+#include "Renderer.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Renderer;
+using namespace Renderer::Math;
+
+namespace
+{
+	// Read only view of a whole file, unmapped when destroyed.
+	class MappedFile
+	{
+	public:
+		explicit MappedFile(const std::string& path)
+		{
+#ifdef _WIN32
+			m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE)
+			{
+				Fail("Failed to open " + path);
+			}
+
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_file, &size))
+			{
+				Fail("Failed to read the size of " + path);
+			}
+			m_size = static_cast<Size>(size.QuadPart);
+			if (m_size == 0u)
+			{
+				Fail(path + " is empty");
+			}
+
+			m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr)
+			{
+				Fail("Failed to map " + path);
+			}
+
+			m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+			if (m_data == nullptr)
+			{
+				Fail("Failed to map " + path);
+			}
+#else
+			m_descriptor = open(path.c_str(), O_RDONLY);
+			if (m_descriptor < 0)
+			{
+				Fail("Failed to open " + path);
+			}
+
+			struct stat status;
+			if (fstat(m_descriptor, &status) != 0)
+			{
+				Fail("Failed to read the size of " + path);
+			}
+			m_size = static_cast<Size>(status.st_size);
+			if (m_size == 0u)
+			{
+				Fail(path + " is empty");
+			}
+
+			void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_descriptor, 0);
+			if (data == MAP_FAILED)
+			{
+				Fail("Failed to map " + path);
+			}
+			madvise(data, m_size, MADV_SEQUENTIAL);
+			m_data = static_cast<const char*>(data);
+#endif
+		}
+		MappedFile(const MappedFile& rhs) = delete;
+		MappedFile& operator=(const MappedFile& rhs) = delete;
+		~MappedFile() { Close(); }
+
+		const char* Begin() const { return m_data; }
+		const char* End() const { return m_data + m_size; }
+		Size Length() const { return m_size; }
+
+	private:
+		void Close()
+		{
+#ifdef _WIN32
+			if (m_data != nullptr)
+			{
+				UnmapViewOfFile(m_data);
+			}
+			if (m_mapping != nullptr)
+			{
+				CloseHandle(m_mapping);
+			}
+			if (m_file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(m_file);
+			}
+			m_mapping = nullptr;
+			m_file = INVALID_HANDLE_VALUE;
+#else
+			if (m_data != nullptr)
+			{
+				munmap(const_cast<char*>(m_data), m_size);
+			}
+			if (m_descriptor >= 0)
+			{
+				close(m_descriptor);
+			}
+			m_descriptor = -1;
+#endif
+			m_data = nullptr;
+		}
+
+		[[noreturn]] void Fail(const std::string& error)
+		{
+			Close();
+			throw std::runtime_error(error);
+		}
+
+		const char* m_data = nullptr;
+		Size m_size = 0u;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#else
+		int m_descriptor = -1;
+#endif
+	};
+
+	std::string Extension(const std::string& path)
+	{
+		std::string extension = std::filesystem::path(path).extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](const char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+		return extension;
+	}
+
+	void LogLoaded(const std::string& path, const Mesh& mesh, const std::chrono::steady_clock::time_point start)
+	{
+		const auto end = std::chrono::steady_clock::now();
+		LOG_INFO("Loaded ", path, " in ", std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), "ms. Vertices: ",
+			mesh.Positions.Count(), ", triangles: ", mesh.TriangleCount());
+	}
+
+	//
+	// OBJ
+	//
+
+	enum class Record
+	{
+		Position,
+		Normal,
+		UV,
+		Face,
+		Other
+	};
+
+	// Lines of one chunk of the file and where its records go in the mesh buffers.
+	struct Chunk
+	{
+		const char* Begin = nullptr;
+		const char* End = nullptr;
+		Size Positions = 0u;
+		Size Normals = 0u;
+		Size UVs = 0u;
+		Size Triangles = 0u;
+	};
+
+	bool IsSpace(const char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	const char* SkipSpaces(const char* p, const char* end)
+	{
+		while (p < end && IsSpace(*p))
+		{
+			++p;
+		}
+		return p;
+	}
+
+	const char* NextLine(const char* p, const char* end)
+	{
+		const auto newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<Size>(end - p)));
+		return newline == nullptr ? end : newline + 1;
+	}
+
+	bool IsLineEnd(const char* p, const char* end)
+	{
+		return p >= end || *p == '\n' || *p == '#';
+	}
+
+	// Moves p past the record keyword at the start of a line.
+	Record ReadRecord(const char*& p, const char* end)
+	{
+		p = SkipSpaces(p, end);
+		const auto keyword = [&](const char* name, const Size length)
+		{
+			if (static_cast<Size>(end - p) > length && std::memcmp(p, name, length) == 0 && IsSpace(p[length]))
+			{
+				p += length;
+				return true;
+			}
+			return false;
+		};
+
+		if (keyword("v", 1u))
+		{
+			return Record::Position;
+		}
+		if (keyword("vn", 2u))
+		{
+			return Record::Normal;
+		}
+		if (keyword("vt", 2u))
+		{
+			return Record::UV;
+		}
+		if (keyword("f", 1u))
+		{
+			return Record::Face;
+		}
+		return Record::Other;
+	}
+
+	bool ReadFloat(const char*& p, const char* end, float& value)
+	{
+		p = SkipSpaces(p, end);
+		if (p < end && *p == '+')
+		{
+			++p;
+		}
+		const auto result = std::from_chars(p, end, value);
+		p = result.ptr;
+		return result.ec == std::errc();
+	}
+
+	// Reads the position index of one face vertex, skipping any texture and normal indices.
+	bool ReadIndex(const char*& p, const char* end, std::int64_t& index)
+	{
+		p = SkipSpaces(p, end);
+		if (p < end && *p == '+')
+		{
+			++p;
+		}
+		const auto result = std::from_chars(p, end, index);
+		p = result.ptr;
+		while (p < end && !IsSpace(*p) && *p != '\n')
+		{
+			++p;
+		}
+		return result.ec == std::errc() && index != 0;
+	}
+
+	Size CountFaceVertices(const char* p, const char* end)
+	{
+		Size count = 0u;
+		while (true)
+		{
+			p = SkipSpaces(p, end);
+			if (IsLineEnd(p, end))
+			{
+				return count;
+			}
+			++count;
+			while (p < end && !IsSpace(*p) && *p != '\n')
+			{
+				++p;
+			}
+		}
+	}
+
+	std::vector<Chunk> SplitLines(const MappedFile& file, const Size chunkSize)
+	{
+		const Size size = std::max(chunkSize, Size(1u));
+		const Size count = std::max((file.Length() + size - 1u) / size, Size(1u));
+		std::vector<Chunk> chunks(count);
+		const char* begin = file.Begin();
+		for (Size i = 0; i < count; ++i)
+		{
+			const char* end = file.End();
+			if (i + 1u < count)
+			{
+				end = std::max(begin, NextLine(file.Begin() + ((i + 1u) * file.Length() / count) - 1u, file.End()));
+			}
+			chunks[i].Begin = begin;
+			chunks[i].End = end;
+			begin = end;
+		}
+		return chunks;
+	}
+
+	//
+	// PLY
+	//
+
+	enum class Type
+	{
+		Int8,
+		UInt8,
+		Int16,
+		UInt16,
+		Int32,
+		UInt32,
+		Float32,
+		Float64
+	};
+
+	struct Property
+	{
+		std::string Name;
+		Type Scalar = Type::Float32;
+		bool List = false;
+		Type Count = Type::UInt8;
+	};
+
+	struct Element
+	{
+		std::string Name;
+		Size Count = 0u;
+		std::vector<Property> Properties;
+
+		bool HasLists() const
+		{
+			return std::any_of(Properties.begin(), Properties.end(), [](const Property& p) { return p.List; });
+		}
+	};
+
+	Size TypeSize(const Type type)
+	{
+		switch (type)
+		{
+		case Type::Int8:
+		case Type::UInt8:
+			return 1u;
+		case Type::Int16:
+		case Type::UInt16:
+			return 2u;
+		case Type::Int32:
+		case Type::UInt32:
+		case Type::Float32:
+			return 4u;
+		default:
+			return 8u;
+		}
+	}
+
+	Type ParseType(const std::string& name)
+	{
+		static const std::map<std::string, Type> types = {
+			{ "char", Type::Int8 }, { "int8", Type::Int8 },
+			{ "uchar", Type::UInt8 }, { "uint8", Type::UInt8 },
+			{ "short", Type::Int16 }, { "int16", Type::Int16 },
+			{ "ushort", Type::UInt16 }, { "uint16", Type::UInt16 },
+			{ "int", Type::Int32 }, { "int32", Type::Int32 },
+			{ "uint", Type::UInt32 }, { "uint32", Type::UInt32 },
+			{ "float", Type::Float32 }, { "float32", Type::Float32 },
+			{ "double", Type::Float64 }, { "float64", Type::Float64 } };
+
+		const auto it = types.find(name);
+		ASSERT(it == types.end(), "Unknown PLY property type " + name);
+		return it->second;
+	}
+
+	template <typename T>
+	T ReadRaw(const char* p, const bool swap)
+	{
+		std::array<char, sizeof(T)> bytes;
+		std::memcpy(bytes.data(), p, sizeof(T));
+		if (swap)
+		{
+			std::reverse(bytes.begin(), bytes.end());
+		}
+		T value;
+		std::memcpy(&value, bytes.data(), sizeof(T));
+		return value;
+	}
+
+	double ReadValue(const char* p, const Type type, const bool swap)
+	{
+		switch (type)
+		{
+		case Type::Int8: return static_cast<double>(ReadRaw<std::int8_t>(p, false));
+		case Type::UInt8: return static_cast<double>(ReadRaw<std::uint8_t>(p, false));
+		case Type::Int16: return static_cast<double>(ReadRaw<std::int16_t>(p, swap));
+		case Type::UInt16: return static_cast<double>(ReadRaw<std::uint16_t>(p, swap));
+		case Type::Int32: return static_cast<double>(ReadRaw<std::int32_t>(p, swap));
+		case Type::UInt32: return static_cast<double>(ReadRaw<std::uint32_t>(p, swap));
+		case Type::Float32: return static_cast<double>(ReadRaw<float>(p, swap));
+		default: return ReadRaw<double>(p, swap);
+		}
+	}
+
+	// Size in bytes of one element, including the list starting at p.
+	Size ElementSize(const Element& element, const char* p, const bool swap)
+	{
+		Size size = 0u;
+		for (const auto& property : element.Properties)
+		{
+			if (property.List)
+			{
+				const auto count = static_cast<Size>(ReadValue(p + size, property.Count, swap));
+				size += TypeSize(property.Count) + (count * TypeSize(property.Scalar));
+			}
+			else
+			{
+				size += TypeSize(property.Scalar);
+			}
+		}
+		return size;
+	}
+}
+
+std::shared_ptr<Mesh> Renderer::LoadMesh(const std::string& path)
+{
+	const auto extension = Extension(path);
+	if (extension == ".obj")
+	{
+		return LoadOBJ(path);
+	}
+	if (extension == ".ply")
+	{
+		return LoadPLY(path);
+	}
+	throw std::runtime_error("Unsupported mesh format " + path);
+}
+
+std::shared_ptr<Mesh> Renderer::LoadOBJ(const std::string& path, const Size chunkSize)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const MappedFile file(path);
+	auto chunks = SplitLines(file, chunkSize);
+
+	// First pass counts the records in each chunk so the second can write straight into place.
+	ThreadPool::Run([&](const Size i)
+	{
+		Chunk& chunk = chunks[i];
+		for (const char* line = chunk.Begin; line < chunk.End; line = NextLine(line, chunk.End))
+		{
+			const char* p = line;
+			switch (ReadRecord(p, chunk.End))
+			{
+			case Record::Position: ++chunk.Positions; break;
+			case Record::Normal: ++chunk.Normals; break;
+			case Record::UV: ++chunk.UVs; break;
+			case Record::Face: chunk.Triangles += std::max(CountFaceVertices(p, chunk.End), Size(2u)) - 2u; break;
+			default: break;
+			}
+		}
+	}, chunks.size(), 1u);
+
+	std::vector<Chunk> offsets(chunks.size());
+	Chunk total;
+	for (Size i = 0; i < chunks.size(); ++i)
+	{
+		offsets[i] = total;
+		total.Positions += chunks[i].Positions;
+		total.Normals += chunks[i].Normals;
+		total.UVs += chunks[i].UVs;
+		total.Triangles += chunks[i].Triangles;
+	}
+
+	Mesh::Buffer3 positions;
+	Mesh::Buffer3 normals;
+	Mesh::Buffer2 uvs;
+	positions.X.resize(total.Positions);
+	positions.Y.resize(total.Positions);
+	positions.Z.resize(total.Positions);
+	normals.X.resize(total.Normals);
+	normals.Y.resize(total.Normals);
+	normals.Z.resize(total.Normals);
+	uvs.U.resize(total.UVs);
+	uvs.V.resize(total.UVs);
+	std::vector<std::uint32_t> indices(total.Triangles * 3u);
+
+	// Exceptions cannot leave a pool job, failures are recorded and thrown afterwards.
+	std::atomic_bool valid = true;
+	ThreadPool::Run([&](const Size i)
+	{
+		const Chunk& chunk = chunks[i];
+		Size position = offsets[i].Positions;
+		Size normal = offsets[i].Normals;
+		Size uv = offsets[i].UVs;
+		Size index = offsets[i].Triangles * 3u;
+
+		const auto resolve = [&](const std::int64_t value) -> std::uint32_t
+		{
+			// Negative indices count back from the last position read.
+			const std::int64_t resolved = value > 0 ? value - 1 : static_cast<std::int64_t>(position) + value;
+			if (resolved < 0 || resolved >= static_cast<std::int64_t>(total.Positions))
+			{
+				valid = false;
+				return 0u;
+			}
+			return static_cast<std::uint32_t>(resolved);
+		};
+
+		for (const char* line = chunk.Begin; line < chunk.End; line = NextLine(line, chunk.End))
+		{
+			const char* p = line;
+			const Record record = ReadRecord(p, chunk.End);
+			if (record == Record::Position)
+			{
+				float x = 0.0f;
+				float y = 0.0f;
+				float z = 0.0f;
+				if (!ReadFloat(p, chunk.End, x) || !ReadFloat(p, chunk.End, y) || !ReadFloat(p, chunk.End, z))
+				{
+					valid = false;
+				}
+				positions.X[position] = x;
+				positions.Y[position] = y;
+				positions.Z[position] = z;
+				++position;
+			}
+			else if (record == Record::Normal)
+			{
+				float x = 0.0f;
+				float y = 0.0f;
+				float z = 0.0f;
+				if (!ReadFloat(p, chunk.End, x) || !ReadFloat(p, chunk.End, y) || !ReadFloat(p, chunk.End, z))
+				{
+					valid = false;
+				}
+				normals.X[normal] = x;
+				normals.Y[normal] = y;
+				normals.Z[normal] = z;
+				++normal;
+			}
+			else if (record == Record::UV)
+			{
+				float u = 0.0f;
+				float v = 0.0f;
+				if (!ReadFloat(p, chunk.End, u))
+				{
+					valid = false;
+				}
+				if (!IsLineEnd(SkipSpaces(p, chunk.End), chunk.End) && !ReadFloat(p, chunk.End, v))
+				{
+					valid = false;
+				}
+				uvs.U[uv] = u;
+				uvs.V[uv] = v;
+				++uv;
+			}
+			else if (record == Record::Face)
+			{
+				const Size count = CountFaceVertices(p, chunk.End);
+				std::uint32_t first = 0u;
+				std::uint32_t previous = 0u;
+				for (Size k = 0; k < count; ++k)
+				{
+					std::int64_t value = 0;
+					if (!ReadIndex(p, chunk.End, value))
+					{
+						valid = false;
+					}
+					const std::uint32_t current = resolve(value);
+
+					// Polygons are split into a fan around their first vertex.
+					if (k == 0u)
+					{
+						first = current;
+					}
+					else if (k >= 2u)
+					{
+						indices[index++] = first;
+						indices[index++] = previous;
+						indices[index++] = current;
+					}
+					previous = current;
+				}
+			}
+		}
+	}, chunks.size(), 1u);
+
+	ASSERT(!valid, "Malformed OBJ file " + path);
+
+	auto mesh = std::make_shared<Mesh>();
+	if (normals.Count() == positions.Count())
+	{
+		mesh->Normals = std::move(normals);
+	}
+	if (uvs.Count() == positions.Count())
+	{
+		mesh->UVs = std::move(uvs);
+	}
+	mesh->Positions = std::move(positions);
+	mesh->Indices = std::move(indices);
+	mesh->Build();
+
+	LogLoaded(path, *mesh, start);
+	return mesh;
+}
+
+std::shared_ptr<Mesh> Renderer::LoadPLY(const std::string& path, const Size chunkSize)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const MappedFile file(path);
+
+	// Header
+	const char* p = file.Begin();
+	const auto readLine = [&]()
+	{
+		ASSERT(p >= file.End(), "Unexpected end of PLY header " + path);
+		const char* end = NextLine(p, file.End());
+		std::istringstream line(std::string(p, end));
+		p = end;
+		return line;
+	};
+
+	std::string magic;
+	readLine() >> magic;
+	ASSERT(magic != "ply", path + " is not a PLY file");
+
+	bool swap = false;
+	std::vector<Element> elements;
+	while (true)
+	{
+		auto line = readLine();
+		std::string keyword;
+		line >> keyword;
+		if (keyword == "end_header")
+		{
+			break;
+		}
+
+		if (keyword == "format")
+		{
+			std::string format;
+			line >> format;
+			ASSERT(format != "binary_little_endian" && format != "binary_big_endian", "Only binary PLY files are supported " + path);
+			const std::uint16_t one = 1u;
+			const bool littleEndian = *reinterpret_cast<const std::uint8_t*>(&one) == 1u;
+			swap = (format == "binary_little_endian") != littleEndian;
+		}
+		else if (keyword == "element")
+		{
+			Element element;
+			line >> element.Name >> element.Count;
+			elements.push_back(element);
+		}
+		else if (keyword == "property")
+		{
+			ASSERT(elements.empty(), "PLY property outside of an element " + path);
+			Property property;
+			std::string type;
+			line >> type;
+			if (type == "list")
+			{
+				std::string countType;
+				line >> countType >> type;
+				property.List = true;
+				property.Count = ParseType(countType);
+			}
+			property.Scalar = ParseType(type);
+			line >> property.Name;
+			elements.back().Properties.push_back(property);
+		}
+	}
+
+	Mesh::Buffer3 positions;
+	Mesh::Buffer3 normals;
+	Mesh::Buffer2 uvs;
+	std::vector<std::uint32_t> indices;
+	std::atomic_bool valid = true;
+
+	for (const auto& element : elements)
+	{
+		if (element.Name == "vertex")
+		{
+			ASSERT(element.HasLists(), "PLY vertices with list properties are not supported " + path);
+
+			// Byte offset of each property inside one vertex.
+			Size stride = 0u;
+			std::map<std::string, std::pair<Size, Type>> layout;
+			for (const auto& property : element.Properties)
+			{
+				layout[property.Name] = { stride, property.Scalar };
+				stride += TypeSize(property.Scalar);
+			}
+			ASSERT(static_cast<Size>(file.End() - p) < element.Count * stride, "Unexpected end of PLY vertex data " + path);
+
+			const auto find = [&](std::initializer_list<const char*> names) -> const std::pair<Size, Type>*
+			{
+				for (const auto name : names)
+				{
+					const auto it = layout.find(name);
+					if (it != layout.end())
+					{
+						return &it->second;
+					}
+				}
+				return nullptr;
+			};
+
+			const std::array<const std::pair<Size, Type>*, 3> position = { find({ "x" }), find({ "y" }), find({ "z" }) };
+			const std::array<const std::pair<Size, Type>*, 3> normal = { find({ "nx" }), find({ "ny" }), find({ "nz" }) };
+			const std::array<const std::pair<Size, Type>*, 2> uv = { find({ "u", "s", "texture_u" }), find({ "v", "t", "texture_v" }) };
+			ASSERT(!position[0] || !position[1] || !position[2], "PLY vertices need x, y and z " + path);
+			const bool hasNormals = normal[0] && normal[1] && normal[2];
+			const bool hasUVs = uv[0] && uv[1];
+
+			positions.X.resize(element.Count);
+			positions.Y.resize(element.Count);
+			positions.Z.resize(element.Count);
+			if (hasNormals)
+			{
+				normals.X.resize(element.Count);
+				normals.Y.resize(element.Count);
+				normals.Z.resize(element.Count);
+			}
+			if (hasUVs)
+			{
+				uvs.U.resize(element.Count);
+				uvs.V.resize(element.Count);
+			}
+
+			const char* data = p;
+			const auto read = [&](const char* vertex, const std::pair<Size, Type>* property)
+			{
+				return static_cast<float>(ReadValue(vertex + property->first, property->second, swap));
+			};
+
+			const Size perChunk = std::max(chunkSize / std::max(stride, Size(1u)), Size(1u));
+			const Size chunks = (element.Count + perChunk - 1u) / perChunk;
+			ThreadPool::Run([&](const Size chunk)
+			{
+				const Size last = std::min((chunk + 1u) * perChunk, element.Count);
+				for (Size i = chunk * perChunk; i < last; ++i)
+				{
+					const char* vertex = data + (i * stride);
+					positions.X[i] = read(vertex, position[0]);
+					positions.Y[i] = read(vertex, position[1]);
+					positions.Z[i] = read(vertex, position[2]);
+					if (hasNormals)
+					{
+						normals.X[i] = read(vertex, normal[0]);
+						normals.Y[i] = read(vertex, normal[1]);
+						normals.Z[i] = read(vertex, normal[2]);
+					}
+					if (hasUVs)
+					{
+						uvs.U[i] = read(vertex, uv[0]);
+						uvs.V[i] = read(vertex, uv[1]);
+					}
+				}
+			}, chunks, 1u);
+
+			p += element.Count * stride;
+		}
+		else if (element.Name == "face")
+		{
+			const auto list = std::find_if(element.Properties.begin(), element.Properties.end(), [](const Property& property)
+			{
+				return property.List && (property.Name == "vertex_indices" || property.Name == "vertex_index");
+			});
+			ASSERT(list == element.Properties.end(), "PLY faces need a vertex_indices list " + path);
+			const Size countSize = TypeSize(list->Count);
+			const Size indexSize = TypeSize(list->Scalar);
+
+			const auto index = [&](const char* value, std::atomic_bool& indexValid) -> std::uint32_t
+			{
+				const auto resolved = static_cast<std::int64_t>(ReadValue(value, list->Scalar, swap));
+				if (resolved < 0 || resolved >= static_cast<std::int64_t>(positions.Count()))
+				{
+					indexValid = false;
+					return 0u;
+				}
+				return static_cast<std::uint32_t>(resolved);
+			};
+
+			// Offset of the index list inside a face, only scalar properties may precede it.
+			Size listOffset = 0u;
+			bool fixedPrefix = true;
+			for (auto it = element.Properties.begin(); it != list; ++it)
+			{
+				fixedPrefix = fixedPrefix && !it->List;
+				listOffset += TypeSize(it->Scalar);
+			}
+
+			// Most files are all triangles, which gives every face the same size and lets them
+			// be read in parallel. Anything else falls back to reading face by face.
+			Size stride = 0u;
+			bool triangles = fixedPrefix && element.Count > 0u;
+			if (triangles)
+			{
+				stride = ElementSize(element, p, swap);
+				triangles = listOffset + countSize + (3u * indexSize) <= stride &&
+					static_cast<Size>(file.End() - p) >= element.Count * stride;
+			}
+
+			// Chunks can read past the first face that is not a triangle before another chunk
+			// finds it, so their indices only count once every face turned out to be a triangle.
+			std::atomic_bool uniform = triangles;
+			std::atomic_bool uniformValid = true;
+			if (triangles)
+			{
+				indices.resize(element.Count * 3u);
+				const char* data = p;
+				const Size perChunk = std::max(chunkSize / stride, Size(1u));
+				const Size chunks = (element.Count + perChunk - 1u) / perChunk;
+				ThreadPool::Run([&](const Size chunk)
+				{
+					const Size last = std::min((chunk + 1u) * perChunk, element.Count);
+					for (Size i = chunk * perChunk; i < last && uniform; ++i)
+					{
+						const char* face = data + (i * stride);
+						if (ElementSize(element, face, swap) != stride ||
+							static_cast<Size>(ReadValue(face + listOffset, list->Count, swap)) != 3u)
+						{
+							uniform = false;
+							return;
+						}
+						const char* values = face + listOffset + countSize;
+						indices[(i * 3u) + 0u] = index(values, uniformValid);
+						indices[(i * 3u) + 1u] = index(values + indexSize, uniformValid);
+						indices[(i * 3u) + 2u] = index(values + (2u * indexSize), uniformValid);
+					}
+				}, chunks, 1u);
+			}
+
+			if (uniform)
+			{
+				valid = valid && uniformValid;
+				p += element.Count * stride;
+				continue;
+			}
+
+			indices.clear();
+			for (Size i = 0; i < element.Count; ++i)
+			{
+				ASSERT(p >= file.End(), "Unexpected end of PLY face data " + path);
+				const char* face = p;
+				const Size size = ElementSize(element, face, swap);
+				ASSERT(static_cast<Size>(file.End() - face) < size, "Unexpected end of PLY face data " + path);
+
+				Size offset = 0u;
+				for (auto it = element.Properties.begin(); it != list; ++it)
+				{
+					offset += it->List ?
+						TypeSize(it->Count) + (static_cast<Size>(ReadValue(face + offset, it->Count, swap)) * TypeSize(it->Scalar)) :
+						TypeSize(it->Scalar);
+				}
+
+				const auto count = static_cast<Size>(ReadValue(face + offset, list->Count, swap));
+				const char* values = face + offset + countSize;
+				for (Size k = 2; k < count; ++k)
+				{
+					indices.push_back(index(values, valid));
+					indices.push_back(index(values + ((k - 1u) * indexSize), valid));
+					indices.push_back(index(values + (k * indexSize), valid));
+				}
+				p += size;
+			}
+		}
+		else
+		{
+			// Unknown elements are skipped.
+			if (!element.HasLists())
+			{
+				p += element.Count * ElementSize(element, p, swap);
+			}
+			else
+			{
+				for (Size i = 0; i < element.Count; ++i)
+				{
+					ASSERT(p >= file.End(), "Unexpected end of PLY data " + path);
+					p += ElementSize(element, p, swap);
+				}
+			}
+			ASSERT(p > file.End(), "Unexpected end of PLY data " + path);
+		}
+	}
+
+	ASSERT(!valid, "Malformed PLY file " + path);
+
+	auto mesh = std::make_shared<Mesh>();
+	mesh->Positions = std::move(positions);
+	mesh->Normals = std::move(normals);
+	mesh->UVs = std::move(uvs);
+	mesh->Indices = std::move(indices);
+	mesh->Build();
+
+	LogLoaded(path, *mesh, start);
+	return mesh;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+using namespace Renderer::Math;
+
+Vector3 Instance::ToLocal(const Vector3& position) const
+{
+	return (position - XForm.GetPosition()).MatrixMultiply(XForm.GetInverse());
+}
+
+Vector3 Instance::ToWorld(const Vector3& position) const
+{
+	return position.MatrixMultiply(XForm.GetAxis()) + XForm.GetPosition();
+}
+
+Vector3 Instance::CalculateNormal(const Object& object, const Size primitive, const Vector3& hit) const
+{
+	// Normals move with the inverse transpose so they stay perpendicular under scaling.
+	auto inverseTranspose = XForm.GetInverse();
+	inverseTranspose.Transpose();
+	return object.CalculateNormal(ToLocal(hit), primitive).MatrixMultiply(inverseTranspose).Normalized();
+}
+
+Intersection Instance::Intersect(const Ray& ray) const
+{
+	if (!Geometry)
+	{
+		return Intersection();
+	}
+
+	// Distances along the local ray are scaled by the instance, the interval is scaled with them.
+	const auto direction = ray.GetDirection().MatrixMultiply(XForm.GetInverse());
+	const float scale = direction.Length();
+	const Ray local(ToLocal(ray.GetOrigin()), direction, ray.GetMinDistance() * scale, ray.GetMaxDistance() * scale);
+	const auto closest = Geometry->Closest(local);
+	if (!closest)
+	{
+		return Intersection();
+	}
+
+	const auto position = ToWorld(closest.Position(local));
+	const float distance = (position - ray.GetOrigin()).DotProduct(ray.GetDirection());
+	return { true, position, closest.Object->Material.Albedo, closest.Object, distance, this, closest.Primitive };
+}
+
+Vector3 Instance::CalculateNormal(const Vector3& hit) const
+{
+	// Hits report the instanced object, this is only a fallback for callers holding the instance.
+	if (Geometry)
+	{
+		const auto local = ToLocal(hit);
+		for (const auto& object : Geometry->GetObjects())
+		{
+			auto bounds = object->Bounds();
+			bounds.Min -= 0.0001f;
+			bounds.Max += 0.0001f;
+			if (local[0] >= bounds.Min[0] && local[1] >= bounds.Min[1] && local[2] >= bounds.Min[2] &&
+				local[0] <= bounds.Max[0] && local[1] <= bounds.Max[1] && local[2] <= bounds.Max[2])
+			{
+				return CalculateNormal(*object, 0u, hit);
+			}
+		}
+	}
+	return (hit - XForm.GetPosition()).Normalized();
+}
+
+BoundingBox Instance::Bounds() const
+{
+	BoundingBox bounds;
+	if (!Geometry || !Geometry->Bounds().IsValid())
+	{
+		return bounds;
+	}
+
+	const auto local = Geometry->Bounds();
+	for (Size i = 0; i < 8; ++i)
+	{
+		const Vector3 corner = {
+			(i & 1u) ? local.Max[0] : local.Min[0],
+			(i & 2u) ? local.Max[1] : local.Min[1],
+			(i & 4u) ? local.Max[2] : local.Min[2] };
+		bounds.Expand(ToWorld(corner));
+	}
+	return bounds;
+}
\ No newline at end of file
@@ -10,20 +10,11 @@ Vector3 Light::Attenuation(const Vector3& colour, const float intensity, const f
 	return (colour * intensity) * attenuation;
 }
 
-float Point::Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const
+float Point::Shadow(const BVH& bvh, const Vector3& hit) const
 {
-	bool shadow = false;
 	const auto direction = XForm.GetPosition() - hit;
-	const auto ray = Ray(hit, direction);
-	const auto intersections = IntersectScene(objects, ray, true);
-	if (!intersections.empty())
-	{
-		const auto difference = direction.Length() - (intersections.front().Position - hit).Length();
-		if (difference > 0.0f)
-		{
-			shadow = true;
-		}
-	}
+	const auto ray = Ray(hit, direction, 0.0f, direction.Length());
+	const bool shadow = IsOccluded(bvh, ray);
 	return shadow ? ShadowIntensity : 0.0f;
 }
 
@@ -34,56 +25,54 @@ Sample Point::Sampler(const Vector3& origin, const Vector3& direction, const Vec
 	return { sample, Colour * Intensity, rayDirection.Length() };
 }
 
-float Area::Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const
+float Area::Shadow(const BVH& bvh, const Vector3& hit) const
 {
-	float shadow = 0.0f;
-	Size samples = static_cast<Size>(std::round(std::sqrt(static_cast<float>(Samples))));
-	for (Size u = 0; u < samples; ++u)
-	{
-		for (Size v = 0; v < samples; ++v)
-		{
-			float offset = 0.0f;
-			if (RenderGeometry)
-			{
-				offset = 1.5f;
-			}
-			const float random1 = Random();
-			const float random2 = Random();
-			const auto position = SamplePlane(random1, random2, u, v, offset);
-			const auto direction = position - hit;
-			const auto ray = Ray(hit, direction);
-
-			const auto intersections = IntersectScene(objects, ray, true);
-			if (!intersections.empty())
-			{
-				const auto difference = direction.Length() - (intersections.front().Position - hit).Length();
-				if (difference > 0.0f)
-				{
-					shadow += 1.0f;
-				}
-			}
-		}
-	}
-	shadow = (shadow / std::pow(static_cast<float>(samples), 2.0f));
-	shadow *= ShadowIntensity;
-	return shadow;
+	return 0.0f;
 }
 
 Sample Area::Sampler(const Vector3& origin, const Vector3& direction, const Vector3& up, const SamplerSettings& settings) const
 {
+	const float random1 = Random();
+	const float random2 = Random();
+	return SampleArea(origin, random1, random2);
+}
+
+Sample Area::SampleArea(const Vector3& origin, const float u, const float v) const
+{
+	const auto position = Grid->UVToWorld(u, v);
+	const auto direction = position - origin;
+	const float distance = direction.Length();
 	Ray sample(origin, direction);
-	return { sample, Colour * Intensity, Grid->XForm.GetPosition().Distance(origin) };
+
+	// Uniform over the area, so the density per solid angle grows with the square of the distance
+	// and as the light turns edge on. Both sides of the light emit.
+	const float cosine = std::abs(Grid->CalculateNormal(position).DotProduct(sample.GetDirection()));
+	const float area = Grid->Width * Grid->Height;
+	const float pdf = cosine > 0.0f && area > 0.0f ? (distance * distance) / (area * cosine) : 0.0f;
+	return { sample, Radiance(), distance, pdf };
+}
+
+float Area::Pdf(const Ray& ray, float& distance) const
+{
+	const auto plane = Grid->Compile();
+	const float hitDistance = Plane::HitDistance(plane, ray);
+	const float cosine = std::abs(plane.Normal.DotProduct(ray.GetDirection()));
+	const float area = Grid->Width * Grid->Height;
+	if (hitDistance == Infinity || cosine <= 0.0f || area <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	distance = hitDistance;
+	return (hitDistance * hitDistance) / (area * cosine);
 }
 
-Vector3 Area::SamplePlane(const float u, const float v, const Size uRegion, const Size vRegion, const float surfaceOffset) const
+Vector3 Area::Radiance() const
 {
-	const float step = 1.0f / static_cast<float>(Samples);
-	const float uOffset = step * uRegion;
-	const float vOffset = step * vRegion;
-	return Grid->UVToWorld(step + uOffset, step + vOffset, surfaceOffset);
+	return Colour * ((Intensity * Intensity) / std::max(Grid->Width * Grid->Height, 0.0001f));
 }
 
-float Enviroment::Shadow(const std::vector<std::shared_ptr<Object>>& objects, const Vector3& hit) const
+float Enviroment::Shadow(const BVH& bvh, const Vector3& hit) const
 {
 	return 0.0f;
 }
@@ -0,0 +1,326 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+using namespace Renderer::Math;
+
+namespace
+{
+	constexpr Size StackSize = 64u;
+	constexpr float DeterminantEpsilon = 1e-12f;
+}
+
+void Mesh::Build()
+{
+	m_nodes.clear();
+	m_packets.clear();
+
+	const Size count = TriangleCount();
+	if (count == 0u)
+	{
+		return;
+	}
+
+	std::vector<std::uint32_t> triangles(count);
+	std::vector<BoundingBox> bounds(count);
+	for (Size i = 0; i < count; ++i)
+	{
+		triangles[i] = static_cast<std::uint32_t>(i);
+		bounds[i].Expand(Positions.Get(Indices[(i * 3u) + 0u]));
+		bounds[i].Expand(Positions.Get(Indices[(i * 3u) + 1u]));
+		bounds[i].Expand(Positions.Get(Indices[(i * 3u) + 2u]));
+	}
+
+	m_nodes.reserve(2u * ((count + Packet::Width - 1u) / Packet::Width));
+	m_packets.reserve((count + Packet::Width - 1u) / Packet::Width);
+	BuildRecursive(triangles, bounds, 0u, count);
+}
+
+Size Mesh::BuildRecursive(std::vector<std::uint32_t>& triangles, const std::vector<BoundingBox>& bounds, const Size start, const Size end)
+{
+	const Size index = m_nodes.size();
+	m_nodes.emplace_back();
+
+	BoundingBox box;
+	BoundingBox centroids;
+	for (Size i = start; i < end; ++i)
+	{
+		box.Expand(bounds[triangles[i]]);
+		centroids.Expand(bounds[triangles[i]].Centroid());
+	}
+	m_nodes[index].Bounds = box;
+
+	const Size count = end - start;
+	if (count <= Packet::Width)
+	{
+		Packet packet;
+		for (Size lane = 0; lane < Packet::Width; ++lane)
+		{
+			// Unused lanes repeat a vertex with zero length edges so their determinant is zero.
+			const std::uint32_t triangle = triangles[start + std::min(lane, count - 1u)];
+			const Vector3 v0 = Positions.Get(Indices[(triangle * 3u) + 0u]);
+			const Vector3 e1 = lane < count ? Positions.Get(Indices[(triangle * 3u) + 1u]) - v0 : Vector3();
+			const Vector3 e2 = lane < count ? Positions.Get(Indices[(triangle * 3u) + 2u]) - v0 : Vector3();
+			packet.V0X[lane] = v0[0];
+			packet.V0Y[lane] = v0[1];
+			packet.V0Z[lane] = v0[2];
+			packet.E1X[lane] = e1[0];
+			packet.E1Y[lane] = e1[1];
+			packet.E1Z[lane] = e1[2];
+			packet.E2X[lane] = e2[0];
+			packet.E2Y[lane] = e2[1];
+			packet.E2Z[lane] = e2[2];
+			packet.Triangle[lane] = triangle;
+		}
+
+		m_nodes[index].Offset = static_cast<std::uint32_t>(m_packets.size());
+		m_nodes[index].Leaf = true;
+		m_packets.push_back(packet);
+		return index;
+	}
+
+	// Median split along the widest centroid axis, rounded so the left side fills whole packets.
+	const Size axis = centroids.LongestAxis();
+	const Size half = ((count / 2u) + Packet::Width - 1u) / Packet::Width * Packet::Width;
+	const Size mid = start + std::min(half, count - 1u);
+	std::nth_element(triangles.begin() + start, triangles.begin() + mid, triangles.begin() + end,
+		[&](const std::uint32_t a, const std::uint32_t b)
+		{
+			return bounds[a].Centroid()[axis] < bounds[b].Centroid()[axis];
+		});
+
+	BuildRecursive(triangles, bounds, start, mid);
+	const Size second = BuildRecursive(triangles, bounds, mid, end);
+	m_nodes[index].Offset = static_cast<std::uint32_t>(second);
+	m_nodes[index].Axis = static_cast<std::uint32_t>(axis);
+	return index;
+}
+
+Size Mesh::IntersectPacket(const Packet& packet, const Ray& ray, float& distance) const
+{
+	const auto& origin = ray.GetOrigin();
+	const auto& direction = ray.GetDirection();
+	alignas(16) std::array<float, Packet::Width> distances;
+	int mask = 0;
+
+#ifdef RENDERER_SSE
+	const __m128 dx = _mm_set1_ps(direction[0]);
+	const __m128 dy = _mm_set1_ps(direction[1]);
+	const __m128 dz = _mm_set1_ps(direction[2]);
+	const __m128 e1x = _mm_load_ps(packet.E1X.data());
+	const __m128 e1y = _mm_load_ps(packet.E1Y.data());
+	const __m128 e1z = _mm_load_ps(packet.E1Z.data());
+	const __m128 e2x = _mm_load_ps(packet.E2X.data());
+	const __m128 e2y = _mm_load_ps(packet.E2Y.data());
+	const __m128 e2z = _mm_load_ps(packet.E2Z.data());
+
+	// p = direction x e2, determinant = e1 . p
+	const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+	const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+	const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+	const __m128 determinant = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+	const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+
+	// t = origin - v0, u = (t . p) / determinant
+	const __m128 tx = _mm_sub_ps(_mm_set1_ps(origin[0]), _mm_load_ps(packet.V0X.data()));
+	const __m128 ty = _mm_sub_ps(_mm_set1_ps(origin[1]), _mm_load_ps(packet.V0Y.data()));
+	const __m128 tz = _mm_sub_ps(_mm_set1_ps(origin[2]), _mm_load_ps(packet.V0Z.data()));
+	const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverse);
+
+	// q = t x e1, v = (direction . q) / determinant, distance = (e2 . q) / determinant
+	const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+	const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+	const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+	const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), inverse);
+	const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), inverse);
+
+	const __m128 absolute = _mm_andnot_ps(_mm_set1_ps(-0.0f), determinant);
+	__m128 hit = _mm_cmpgt_ps(absolute, _mm_set1_ps(DeterminantEpsilon));
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(u, _mm_setzero_ps()));
+	hit = _mm_and_ps(hit, _mm_cmpge_ps(v, _mm_setzero_ps()));
+	hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+	hit = _mm_and_ps(hit, _mm_cmpgt_ps(t, _mm_set1_ps(ray.GetMinDistance())));
+	hit = _mm_and_ps(hit, _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+	_mm_store_ps(distances.data(), t);
+	mask = _mm_movemask_ps(hit);
+#else
+	for (Size lane = 0; lane < Packet::Width; ++lane)
+	{
+		const Vector3 e1 = { packet.E1X[lane], packet.E1Y[lane], packet.E1Z[lane] };
+		const Vector3 e2 = { packet.E2X[lane], packet.E2Y[lane], packet.E2Z[lane] };
+		const Vector3 p = direction.CrossProduct(e2);
+		const float determinant = e1.DotProduct(p);
+		if (std::abs(determinant) <= DeterminantEpsilon)
+		{
+			continue;
+		}
+
+		const float inverse = 1.0f / determinant;
+		const Vector3 v0 = { packet.V0X[lane], packet.V0Y[lane], packet.V0Z[lane] };
+		const Vector3 t = origin - v0;
+		const float u = t.DotProduct(p) * inverse;
+		const Vector3 q = t.CrossProduct(e1);
+		const float v = direction.DotProduct(q) * inverse;
+		distances[lane] = e2.DotProduct(q) * inverse;
+		if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && distances[lane] > ray.GetMinDistance() && distances[lane] < distance)
+		{
+			mask |= 1 << lane;
+		}
+	}
+#endif
+
+	Size closest = Packet::Width;
+	for (Size lane = 0; lane < Packet::Width; ++lane)
+	{
+		if ((mask & (1 << lane)) != 0 && distances[lane] < distance)
+		{
+			distance = distances[lane];
+			closest = lane;
+		}
+	}
+	return closest;
+}
+
+Intersection Mesh::Intersect(const Ray& ray) const
+{
+	if (m_nodes.empty())
+	{
+		return Intersection();
+	}
+
+	const auto& direction = ray.GetDirection();
+	const auto& sign = ray.GetSign();
+	float closestDistance = ray.GetMaxDistance();
+	Size closestTriangle = 0u;
+	bool hit = false;
+
+	std::array<Size, StackSize> stack;
+	Size stackSize = 0u;
+	stack[stackSize++] = 0u;
+
+	while (stackSize > 0u)
+	{
+		const Size index = stack[--stackSize];
+		const Node& node = m_nodes[index];
+
+		float distance = 0.0f;
+		if (!node.Bounds.Intersect(ray, ray.GetMinDistance(), closestDistance, distance))
+		{
+			continue;
+		}
+
+		if (node.Leaf)
+		{
+			const Packet& packet = m_packets[node.Offset];
+			const Size lane = IntersectPacket(packet, ray, closestDistance);
+			if (lane < Packet::Width)
+			{
+				closestTriangle = packet.Triangle[lane];
+				hit = true;
+			}
+			continue;
+		}
+
+		if (sign[node.Axis] != 0u)
+		{
+			stack[stackSize++] = index + 1u;
+			stack[stackSize++] = node.Offset;
+		}
+		else
+		{
+			stack[stackSize++] = node.Offset;
+			stack[stackSize++] = index + 1u;
+		}
+	}
+
+	if (!hit)
+	{
+		return Intersection();
+	}
+
+	const Vector3 position = ray.GetOrigin() + (direction * closestDistance);
+	return { true, position, Material.Albedo, static_cast<const Object*>(this), closestDistance, nullptr, closestTriangle };
+}
+
+Vector3 Mesh::Barycentric(const Vector3& hit, const Size triangle) const
+{
+	const Vector3 v0 = Positions.Get(Indices[(triangle * 3u) + 0u]);
+	const Vector3 e1 = Positions.Get(Indices[(triangle * 3u) + 1u]) - v0;
+	const Vector3 e2 = Positions.Get(Indices[(triangle * 3u) + 2u]) - v0;
+	const Vector3 p = hit - v0;
+
+	const float d11 = e1.DotProduct(e1);
+	const float d12 = e1.DotProduct(e2);
+	const float d22 = e2.DotProduct(e2);
+	const float dp1 = p.DotProduct(e1);
+	const float dp2 = p.DotProduct(e2);
+	const float denominator = (d11 * d22) - (d12 * d12);
+	if (std::abs(denominator) <= DeterminantEpsilon)
+	{
+		return { 1.0f, 0.0f, 0.0f };
+	}
+
+	const float u = ((d22 * dp1) - (d12 * dp2)) / denominator;
+	const float v = ((d11 * dp2) - (d12 * dp1)) / denominator;
+	return { 1.0f - u - v, u, v };
+}
+
+Vector2 Mesh::CalculateUV(const Vector3& hit, const Size triangle) const
+{
+	if (UVs.Count() != Positions.Count())
+	{
+		return { 0.0f, 0.0f };
+	}
+
+	const auto weights = Barycentric(hit, triangle);
+	const auto uv0 = UVs.Get(Indices[(triangle * 3u) + 0u]);
+	const auto uv1 = UVs.Get(Indices[(triangle * 3u) + 1u]);
+	const auto uv2 = UVs.Get(Indices[(triangle * 3u) + 2u]);
+	return (uv0 * weights[0]) + (uv1 * weights[1]) + (uv2 * weights[2]);
+}
+
+Vector3 Mesh::CalculateNormal(const Vector3& hit, const Size triangle) const
+{
+	if (Normals.Count() == Positions.Count())
+	{
+		const auto weights = Barycentric(hit, triangle);
+		const auto n0 = Normals.Get(Indices[(triangle * 3u) + 0u]);
+		const auto n1 = Normals.Get(Indices[(triangle * 3u) + 1u]);
+		const auto n2 = Normals.Get(Indices[(triangle * 3u) + 2u]);
+		return ((n0 * weights[0]) + (n1 * weights[1]) + (n2 * weights[2])).Normalized();
+	}
+
+	const Vector3 v0 = Positions.Get(Indices[(triangle * 3u) + 0u]);
+	const Vector3 e1 = Positions.Get(Indices[(triangle * 3u) + 1u]) - v0;
+	const Vector3 e2 = Positions.Get(Indices[(triangle * 3u) + 2u]) - v0;
+	return e1.CrossProduct(e2).Normalized();
+}
+
+Vector3 Mesh::CalculateNormal(const Vector3& hit) const
+{
+	// Without the triangle from Intersect, use the one whose plane lies closest to the hit.
+	Size closest = 0u;
+	float closestDistance = Infinity;
+	for (Size i = 0; i < TriangleCount(); ++i)
+	{
+		const auto weights = Barycentric(hit, i);
+		if (weights[0] < -0.0001f || weights[1] < -0.0001f || weights[2] < -0.0001f)
+		{
+			continue;
+		}
+
+		const Vector3 v0 = Positions.Get(Indices[i * 3u]);
+		const float distance = std::abs((hit - v0).DotProduct(CalculateNormal(hit, i)));
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closest = i;
+		}
+	}
+	return CalculateNormal(hit, closest);
+}
+
+BoundingBox Mesh::Bounds() const
+{
+	return m_nodes.empty() ? BoundingBox() : m_nodes.front().Bounds;
+}
\ No newline at end of file
@@ -53,83 +53,172 @@ Vector3 Plane::CalculateNormal(const Vector3& hit) const
 	return { x, y, z };
 }
 
-Intersection Plane::Intersect(const Ray& ray) const 
+Plane::Compiled Plane::Compile() const
 {
-	const float x = XForm.GetAxis().Get(1, 0);
-	const float y = XForm.GetAxis().Get(1, 1);
-	const float z = XForm.GetAxis().Get(1, 2);
-	const Vector3 normal = { x, y, z };
+	const auto& axis = XForm.GetAxis();
+	const auto& inverse = XForm.GetInverse();
 
-	const auto difference = ray.GetDirection().DotProduct(normal);
+	Compiled plane;
+	plane.Position = XForm.GetPosition();
+	plane.Normal = { axis.Get(1, 0), axis.Get(1, 1), axis.Get(1, 2) };
+	plane.U = { inverse.Get(0, 0), inverse.Get(1, 0), inverse.Get(2, 0) };
+	plane.V = { inverse.Get(0, 2), inverse.Get(1, 2), inverse.Get(2, 2) };
+	plane.HalfWidth = Width / 2.0f;
+	plane.HalfHeight = Height / 2.0f;
+	return plane;
+}
 
-	if (std::abs(difference) > 0.0f)
+float Plane::HitDistance(const Compiled& plane, const Ray& ray)
+{
+	const auto difference = ray.GetDirection().DotProduct(plane.Normal);
+	if (difference == 0.0f)
 	{
-		const auto direction = XForm.GetPosition() - ray.GetOrigin();
-		const auto surfaceDistance = direction.DotProduct(normal) / difference;
-		const bool hit = surfaceDistance >= 0.0f;
-		if (hit)
-		{
-			const Vector3 position = (ray.GetDirection() * surfaceDistance) + ray.GetOrigin();
-			const auto pLocal = position - XForm.GetPosition();
+		return Infinity;
+	}
 
-            const auto& inverse = XForm.GetInverse();
-            const auto local = pLocal.MatrixMultiply(inverse);
+	const auto direction = plane.Position - ray.GetOrigin();
+	const auto surfaceDistance = direction.DotProduct(plane.Normal) / difference;
+	if (surfaceDistance < ray.GetMinDistance() || surfaceDistance > ray.GetMaxDistance())
+	{
+		return Infinity;
+	}
 
-			const auto halfWidth = Width / 2.0f;
-			const auto halfHeight = Height / 2.0f;
+	const auto local = (ray.GetDirection() * surfaceDistance) - direction;
+	const auto xDistance = local.DotProduct(plane.U);
+	const auto yDistance = local.DotProduct(plane.V);
 
-            const auto xDistance = local[0];
-            const auto yDistance = local[2];
+	if (xDistance > -plane.HalfWidth && xDistance < plane.HalfWidth &&
+		yDistance > -plane.HalfHeight && yDistance < plane.HalfHeight)
+	{
+		return surfaceDistance;
+	}
+	return Infinity;
+}
 
-			if (xDistance > -halfWidth && xDistance < halfWidth &&
-				yDistance > -halfHeight && yDistance < halfHeight)
-			{
-				return { true,  position, Material.Albedo, static_cast<const Object*>(this) };
-			}
-		}
+Intersection Plane::Intersect(const Ray& ray) const 
+{
+	const float distance = HitDistance(Compile(), ray);
+	if (distance == Infinity)
+	{
+		return Intersection();
 	}
 
-	return Intersection();
+	const Vector3 position = (ray.GetDirection() * distance) + ray.GetOrigin();
+	return { true, position, Material.Albedo, static_cast<const Object*>(this), distance };
 }
 
-Intersection Sphere::Intersect(const Ray& ray) const
+BoundingBox Plane::Bounds() const
+{
+	// Planes have no thickness so pad the box to keep the slab test stable.
+	constexpr float padding = 0.0001f;
+	BoundingBox bounds;
+	bounds.Expand(UVToWorld(0.0f, 0.0f));
+	bounds.Expand(UVToWorld(1.0f, 0.0f));
+	bounds.Expand(UVToWorld(0.0f, 1.0f));
+	bounds.Expand(UVToWorld(1.0f, 1.0f));
+	bounds.Min -= padding;
+	bounds.Max += padding;
+	return bounds;
+}
+
+float Sphere::HitDistance(const Compiled& sphere, const Ray& ray)
 {
-	const auto sphereToRay = XForm.GetPosition() - ray.GetOrigin();
-	const auto sign = sphereToRay.DotProduct(ray.GetDirection());
+	const auto sphereToRay = sphere.Centre - ray.GetOrigin();
+	const float projection = sphereToRay.DotProduct(ray.GetDirection());
+	const float outside = sphereToRay.DotProduct(sphereToRay) - sphere.RadiusSquared;
 
-	if (sign < 0.0f)
+	// Rays starting outside and pointing away can never hit.
+	if (outside > 0.0f && projection < 0.0f)
 	{
-		if (sphereToRay.Length() > Radius)
-		{
-			return Intersection();
-		}
-		if (sphereToRay.Length() == Radius)
-		{
-			// TODO: Check this but it should be the case when the ray origin is on the edge of the sphere.
-			return { true, ray.GetOrigin(), Material.Albedo, static_cast<const Object*>(this) };
-		}
+		return Infinity;
 	}
 
-	const Vector3 projection = ray.Projection(XForm.GetPosition());
-	if ((XForm.GetPosition() - projection).Length() > Radius)
+	// The discriminant from the distance between the centre and the ray keeps its precision
+	// for small spheres far along the ray.
+	const auto perpendicular = sphereToRay - (ray.GetDirection() * projection);
+	const float discriminant = sphere.RadiusSquared - perpendicular.DotProduct(perpendicular);
+	if (discriminant < 0.0f)
 	{
-		return Intersection();
+		return Infinity;
 	}
 
-	const Vector3 projMinusPos = projection - XForm.GetPosition();
-	const float distance = std::sqrt((Radius * Radius) - (projMinusPos.Length() * projMinusPos.Length()));
+	// The root furthest from zero is found directly and the other from their product,
+	// so neither is the difference of two close values.
+	const float root = std::sqrt(discriminant);
+	const float q = projection >= 0.0f ? projection + root : projection - root;
+	const float other = q != 0.0f ? outside / q : 0.0f;
+	const float closer = std::min(q, other);
+	const float further = std::max(q, other);
+
+	// The near side is skipped when it is before the interval or at its very start, which is
+	// where rays leaving the surface begin.
+	if (closer > ray.GetMinDistance() && closer <= ray.GetMaxDistance())
+	{
+		return closer;
+	}
+	return further >= ray.GetMinDistance() && further <= ray.GetMaxDistance() ? further : Infinity;
+}
 
-	float offset = (projection - ray.GetOrigin()).Length();
-	if (sphereToRay.Length() > Radius)
+void Sphere::HitDistances(const float* x, const float* y, const float* z, const float* radiusSquared, const Ray& ray, float* distances)
+{
+#ifdef RENDERER_SSE
+	// Same operations in the same order as HitDistance, the early outs become masks.
+	const auto& origin = ray.GetOrigin();
+	const auto& direction = ray.GetDirection();
+	const __m128 dx = _mm_set1_ps(direction[0]);
+	const __m128 dy = _mm_set1_ps(direction[1]);
+	const __m128 dz = _mm_set1_ps(direction[2]);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 r2 = _mm_loadu_ps(radiusSquared);
+
+	const __m128 sx = _mm_sub_ps(_mm_loadu_ps(x), _mm_set1_ps(origin[0]));
+	const __m128 sy = _mm_sub_ps(_mm_loadu_ps(y), _mm_set1_ps(origin[1]));
+	const __m128 sz = _mm_sub_ps(_mm_loadu_ps(z), _mm_set1_ps(origin[2]));
+	const __m128 projection = _mm_add_ps(_mm_add_ps(_mm_add_ps(zero, _mm_mul_ps(sx, dx)), _mm_mul_ps(sy, dy)), _mm_mul_ps(sz, dz));
+	const __m128 outside = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(zero, _mm_mul_ps(sx, sx)), _mm_mul_ps(sy, sy)), _mm_mul_ps(sz, sz)), r2);
+
+	const __m128 px = _mm_sub_ps(sx, _mm_mul_ps(dx, projection));
+	const __m128 py = _mm_sub_ps(sy, _mm_mul_ps(dy, projection));
+	const __m128 pz = _mm_sub_ps(sz, _mm_mul_ps(dz, projection));
+	const __m128 discriminant = _mm_sub_ps(r2, _mm_add_ps(_mm_add_ps(_mm_add_ps(zero, _mm_mul_ps(px, px)), _mm_mul_ps(py, py)), _mm_mul_ps(pz, pz)));
+
+	const __m128 root = _mm_sqrt_ps(discriminant);
+	const __m128 forwards = _mm_cmpge_ps(projection, zero);
+	const __m128 q = _mm_or_ps(_mm_and_ps(forwards, _mm_add_ps(projection, root)), _mm_andnot_ps(forwards, _mm_sub_ps(projection, root)));
+	const __m128 other = _mm_and_ps(_mm_cmpneq_ps(q, zero), _mm_div_ps(outside, q));
+	const __m128 closer = _mm_min_ps(other, q);
+	const __m128 further = _mm_max_ps(other, q);
+
+	const __m128 minimum = _mm_set1_ps(ray.GetMinDistance());
+	const __m128 maximum = _mm_set1_ps(ray.GetMaxDistance());
+	const __m128 useCloser = _mm_and_ps(_mm_cmpgt_ps(closer, minimum), _mm_cmple_ps(closer, maximum));
+	const __m128 useFurther = _mm_and_ps(_mm_cmpge_ps(further, minimum), _mm_cmple_ps(further, maximum));
+	const __m128 missed = _mm_or_ps(
+		_mm_and_ps(_mm_cmpgt_ps(outside, zero), _mm_cmplt_ps(projection, zero)),
+		_mm_cmplt_ps(discriminant, zero));
+
+	const __m128 infinity = _mm_set1_ps(Infinity);
+	__m128 distance = _mm_or_ps(_mm_and_ps(useFurther, further), _mm_andnot_ps(useFurther, infinity));
+	distance = _mm_or_ps(_mm_and_ps(useCloser, closer), _mm_andnot_ps(useCloser, distance));
+	distance = _mm_or_ps(_mm_and_ps(missed, infinity), _mm_andnot_ps(missed, distance));
+	_mm_storeu_ps(distances, distance);
+#else
+	for (Size i = 0; i < BatchWidth; ++i)
 	{
-		offset -= distance;
+		distances[i] = HitDistance({ { x[i], y[i], z[i] }, radiusSquared[i] }, ray);
 	}
-	else
+#endif
+}
+
+Intersection Sphere::Intersect(const Ray& ray) const
+{
+	const float distance = HitDistance(Compile(), ray);
+	if (distance == Infinity)
 	{
-		offset += distance;
+		return Intersection();
 	}
 
-	return { true, ray.GetOrigin() + (ray.GetDirection() * offset), Material.Albedo, static_cast<const Object*>(this) };
+	return { true, ray.GetOrigin() + (ray.GetDirection() * distance), Material.Albedo, static_cast<const Object*>(this), distance };
 }
 
 Vector3 Sphere::CalculateNormal(const Vector3& hit) const
@@ -137,38 +226,56 @@ Vector3 Sphere::CalculateNormal(const Vector3& hit) const
 	return (hit - XForm.GetPosition()).Normalized();
 }
 
-Intersection Cube::Intersect(const Ray& ray) const
+BoundingBox Sphere::Bounds() const
 {
-	const auto halfVector = { Width / 2.0f, Height / 2.0f, Length / 2.0f };
-	const auto min = XForm.GetPosition() - halfVector;
-	const auto max = XForm.GetPosition() + halfVector;
-
-	const auto& origin = ray.GetOrigin();
-	const auto& direction = ray.GetDirection();
-	float t1 = (min[0] - origin[0]) * (1.0f / direction[0]);
-	float t2 = (max[0] - origin[0]) * (1.0f / direction[0]);
-	float t3 = (min[1] - origin[1]) * (1.0f / direction[1]);
-	float t4 = (max[1] - origin[1]) * (1.0f / direction[1]);
-	float t5 = (min[2] - origin[2]) * (1.0f / direction[2]);
-	float t6 = (max[2] - origin[2]) * (1.0f / direction[2]);
+	return { XForm.GetPosition() - Radius, XForm.GetPosition() + Radius };
+}
 
-	float tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
-	float tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
+Cube::Compiled Cube::Compile() const
+{
+	const Vector3 halfVector = { Width / 2.0f, Height / 2.0f, Length / 2.0f };
+	return { XForm.GetPosition() - halfVector, XForm.GetPosition() + halfVector };
+}
 
-	float distance = tmin;
+float Cube::HitDistance(const Compiled& cube, const Ray& ray)
+{
+	const auto& origin = ray.GetOrigin();
+	const auto& inverse = ray.GetInverseDirection();
+	const auto& sign = ray.GetSign();
+	const std::array<const Vector3*, 2> corners = { &cube.Min, &cube.Max };
+
+	// The sign picks the slab each axis is entered and left through, so no min or max is needed per axis.
+	const float x1 = ((*corners[sign[0]])[0] - origin[0]) * inverse[0];
+	const float x2 = ((*corners[1u - sign[0]])[0] - origin[0]) * inverse[0];
+	const float y1 = ((*corners[sign[1]])[1] - origin[1]) * inverse[1];
+	const float y2 = ((*corners[1u - sign[1]])[1] - origin[1]) * inverse[1];
+	const float z1 = ((*corners[sign[2]])[2] - origin[2]) * inverse[2];
+	const float z2 = ((*corners[1u - sign[2]])[2] - origin[2]) * inverse[2];
+
+	const float tmin = std::max(std::max(x1, y1), z1);
+	const float tmax = std::min(std::min(x2, y2), z2);
+
+	// Rays starting inside do not hit.
+	const bool hit = tmin <= tmax && tmin >= ray.GetMinDistance() && tmin <= ray.GetMaxDistance();
+	return hit ? tmin : Infinity;
+}
 
-	if (tmax < 0.0f || tmin < 0.0f)
+Intersection Cube::Intersect(const Ray& ray) const
+{
+	const float distance = HitDistance(Compile(), ray);
+	if (distance == Infinity)
 	{
 		return Intersection();
 	}
 
-	if (tmin > tmax)
-	{
-		return Intersection();
-	}
+	const Vector3 t = ray.GetOrigin() + (ray.GetDirection() * distance);
+	return { true, t, Material.Albedo, static_cast<const Object*>(this), distance };
+}
 
-	const Vector3 t = origin + (direction * distance);
-	return { true, t, Material.Albedo, static_cast<const Object*>(this) };
+BoundingBox Cube::Bounds() const
+{
+	const auto cube = Compile();
+	return { cube.Min, cube.Max };
 }
 
 Vector3 Cube::CalculateNormal(const Vector3& hit) const
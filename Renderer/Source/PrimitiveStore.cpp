@@ -0,0 +1,246 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+using namespace Renderer::Math;
+
+PrimitiveStore::Type PrimitiveStore::Classify(const Object& object)
+{
+	const std::type_info& type = typeid(object);
+	if (type == typeid(Sphere))
+	{
+		return Type::Sphere;
+	}
+	if (type == typeid(Plane))
+	{
+		return Type::Plane;
+	}
+	if (type == typeid(Cube))
+	{
+		return Type::Cube;
+	}
+	return Type::Other;
+}
+
+namespace
+{
+	// Compiled data is plain floats, compared bit for bit.
+	template <typename T>
+	bool Assign(T& target, const T& value)
+	{
+		if (std::memcmp(&target, &value, sizeof(T)) == 0)
+		{
+			return false;
+		}
+		target = value;
+		return true;
+	}
+}
+
+void PrimitiveStore::Build(const std::vector<std::shared_ptr<Object>>& objects)
+{
+	Clear();
+	m_slots.resize(objects.size());
+	m_objects.resize(objects.size());
+	m_bounds.resize(objects.size());
+
+	for (Size i = 0; i < objects.size(); ++i)
+	{
+		m_sphereCount += Classify(*objects[i]) == Type::Sphere ? 1u : 0u;
+	}
+	m_spheres.Resize(m_sphereCount);
+	m_sphereCount = 0u;
+
+	for (Size i = 0; i < objects.size(); ++i)
+	{
+		Slot& slot = m_slots[i];
+		slot.Kind = Classify(*objects[i]);
+		switch (slot.Kind)
+		{
+		case Type::Sphere:
+			slot.Index = static_cast<std::uint32_t>(m_sphereCount++);
+			break;
+		case Type::Plane:
+			slot.Index = static_cast<std::uint32_t>(m_planes.size());
+			m_planes.emplace_back();
+			break;
+		case Type::Cube:
+			slot.Index = static_cast<std::uint32_t>(m_cubes.size());
+			m_cubes.emplace_back();
+			break;
+		default:
+			break;
+		}
+
+		m_objects[i] = objects[i].get();
+		Compile(*objects[i], i);
+	}
+}
+
+bool PrimitiveStore::Update(const std::vector<std::shared_ptr<Object>>& objects)
+{
+	ASSERT(objects.size() != m_slots.size(), "Primitive store updated with a different set of objects.");
+
+	bool changed = false;
+	for (Size i = 0; i < objects.size(); ++i)
+	{
+		changed = Compile(*objects[i], i) || changed;
+	}
+	return changed;
+}
+
+bool PrimitiveStore::Compile(const Object& object, const Size i)
+{
+	const Slot& slot = m_slots[i];
+	bool changed = Assign(m_bounds[i], object.Bounds());
+	switch (slot.Kind)
+	{
+	case Type::Sphere:
+		changed = m_spheres.Assign(slot.Index, static_cast<const Sphere&>(object).Compile()) || changed;
+		break;
+	case Type::Plane:
+		changed = Assign(m_planes[slot.Index], static_cast<const Plane&>(object).Compile()) || changed;
+		break;
+	case Type::Cube:
+		changed = Assign(m_cubes[slot.Index], static_cast<const Cube&>(object).Compile()) || changed;
+		break;
+	default:
+		break;
+	}
+	return changed;
+}
+
+void PrimitiveStore::SphereArrays::Resize(const Size count)
+{
+	// Padding lanes have a negative radius and never hit.
+	const Size padded = count > 0u ? count + Sphere::BatchWidth - 1u : 0u;
+	X.assign(padded, 0.0f);
+	Y.assign(padded, 0.0f);
+	Z.assign(padded, 0.0f);
+	RadiusSquared.assign(padded, -1.0f);
+}
+
+bool PrimitiveStore::SphereArrays::Assign(const Size i, const Sphere::Compiled& sphere)
+{
+	bool changed = ::Assign(X[i], sphere.Centre[0]);
+	changed = ::Assign(Y[i], sphere.Centre[1]) || changed;
+	changed = ::Assign(Z[i], sphere.Centre[2]) || changed;
+	return ::Assign(RadiusSquared[i], sphere.RadiusSquared) || changed;
+}
+
+void PrimitiveStore::Clear()
+{
+	m_slots.clear();
+	m_objects.clear();
+	m_bounds.clear();
+	m_spheres.Resize(0u);
+	m_sphereCount = 0u;
+	m_planes.clear();
+	m_cubes.clear();
+}
+
+template <typename Visitor>
+void PrimitiveStore::Visit(const Ray& ray, const Size start, const Size count, Visitor&& visit) const
+{
+	const Size end = start + count;
+	for (Size i = start; i < end;)
+	{
+		const Slot& first = m_slots[i];
+		Size length = 1u;
+		while (i + length < end && m_slots[i + length].Kind == first.Kind)
+		{
+			++length;
+		}
+
+		// Built-in primitives report their distance only, visit gets an Intersection without a position.
+		const auto report = [&](const Size k, const float distance) -> bool
+		{
+			if (distance == Infinity)
+			{
+				return true;
+			}
+
+			Intersection intersection;
+			intersection.Hit = true;
+			intersection.Object = m_objects[i + k];
+			intersection.Distance = distance;
+			return visit(intersection);
+		};
+
+		switch (first.Kind)
+		{
+		case Type::Sphere:
+			for (Size k = 0; k < length; k += Sphere::BatchWidth)
+			{
+				const Size index = first.Index + k;
+				alignas(16) std::array<float, Sphere::BatchWidth> distances;
+				Sphere::HitDistances(&m_spheres.X[index], &m_spheres.Y[index], &m_spheres.Z[index], &m_spheres.RadiusSquared[index], ray, distances.data());
+
+				const Size lanes = std::min(Sphere::BatchWidth, length - k);
+				for (Size lane = 0; lane < lanes; ++lane)
+				{
+					if (!report(k + lane, distances[lane]))
+					{
+						return;
+					}
+				}
+			}
+			break;
+		case Type::Plane:
+			for (Size k = 0; k < length; ++k)
+			{
+				if (!report(k, Plane::HitDistance(m_planes[first.Index + k], ray)))
+				{
+					return;
+				}
+			}
+			break;
+		case Type::Cube:
+			for (Size k = 0; k < length; ++k)
+			{
+				if (!report(k, Cube::HitDistance(m_cubes[first.Index + k], ray)))
+				{
+					return;
+				}
+			}
+			break;
+		default:
+			for (Size k = 0; k < length; ++k)
+			{
+				const Intersection intersection = m_objects[i + k]->Intersect(ray);
+				if (intersection.Hit && !visit(intersection))
+				{
+					return;
+				}
+			}
+			break;
+		}
+
+		i += length;
+	}
+}
+
+void PrimitiveStore::Closest(const Ray& ray, const Size start, const Size count, HitRecord& closest) const
+{
+	Visit(ray, start, count, [&](const Intersection& intersection) -> bool
+	{
+		if (intersection.Distance >= ray.GetMinDistance() && intersection.Distance < closest.Distance)
+		{
+			closest.Distance = intersection.Distance;
+			closest.Object = intersection.Object;
+			closest.Instance = intersection.Instance;
+			closest.Primitive = intersection.Primitive;
+		}
+		return true;
+	});
+}
+
+bool PrimitiveStore::Occluded(const Ray& ray, const Size start, const Size count) const
+{
+	bool occluded = false;
+	Visit(ray, start, count, [&](const Intersection& intersection) -> bool
+	{
+		occluded = intersection.Distance < ray.GetMaxDistance();
+		return !occluded;
+	});
+	return occluded;
+}
\ No newline at end of file
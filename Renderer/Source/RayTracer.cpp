@@ -11,45 +11,298 @@ namespace
         std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
         return std::chrono::time_point_cast<std::chrono::seconds>(now).time_since_epoch();
     }
+
+    // Packets cover square blocks of pixels.
+    constexpr Size PacketSide = 4u;
+    static_assert(PacketSide * PacketSide == RayPacket::Width, "A packet covers PacketSide x PacketSide pixels.");
+
+    float Luminance(const Vector3& colour)
+    {
+        return (0.2126f * colour[0]) + (0.7152f * colour[1]) + (0.0722f * colour[2]);
+    }
+
+    // Most samples an adaptive pixel takes, two are needed before there is a variance.
+    Size AdaptiveMaximum(const RayTracer::Settings& settings)
+    {
+        return std::max(settings.MaxSamples, Size(2u));
+    }
 }
 
 const Viewport& RayTracer::Render(
     const std::function<void(const  Viewport::Pixels&, const std::string&)>& save,
     const std::string& path)
 {
-    std::vector<Size> indicies(static_cast<Size>(mCamera.GetViewport().Area()));
-    std::iota(indicies.begin(), indicies.end(), 0u);
-    std::shuffle(indicies.begin(), indicies.end(), std::mt19937{ std::random_device{}() });
+    auto& viewport = mCamera.GetViewport();
+    const auto tiles = CreateTiles(viewport.Columns(), viewport.Rows(), mSettings.TileSize, mSettings.Order);
+    mSampleCounts = Matrix<Size>(viewport.Rows(), viewport.Columns());
 
     auto job = [&](const Size i) -> void
     {
-        const Size index = indicies[i];
+        // Each worker shades a whole tile into its own buffer and writes it to the viewport once.
+        thread_local std::vector<Vector3> colours;
+        thread_local std::vector<Size> counts;
 
-        auto colour = Vector3();
-        for (Size s = 0; s < mSettings.SamplesPerPixel; ++s)
+        const auto& tile = tiles[i];
+        colours.resize(tile.Area());
+        counts.assign(tile.Area(), mSettings.SamplesPerPixel);
+
+        const auto write = [&]()
+        {
+            viewport.SetTile(tile, colours);
+            for (Size row = 0; row < tile.Height; ++row)
+            {
+                for (Size column = 0; column < tile.Width; ++column)
+                {
+                    mSampleCounts.Set(tile.X + column, tile.Y + row, counts[(row * tile.Width) + column]);
+                }
+            }
+        };
+
+        if (mSettings.Mode == Integrator::Wavefront)
         {
-            const auto ray = mCamera.CreateRay(index);
-            const auto raytrace = Trace(ray);
-            colour += raytrace.SurfaceColour;
+            TraceWavefront(tile, colours);
+            write();
+            return;
+        }
+
+        if (mSettings.PacketTracing)
+        {
+            TracePackets(tile, colours);
+            write();
+            return;
+        }
+
+        for (Size row = 0; row < tile.Height; ++row)
+        {
+            for (Size column = 0; column < tile.Width; ++column)
+            {
+                const Size index = viewport.Index(tile.X + column, tile.Y + row);
+
+                auto colour = Vector3();
+                for (Size s = 0; s < mSettings.SamplesPerPixel; ++s)
+                {
+                    colour += Sample(index, s);
+                }
+                colour *= 1.0f / static_cast<float>(mSettings.SamplesPerPixel);
+                colour.Clamp(0.0f, 0.9999f);
+
+                colours[(row * tile.Width) + column] = colour;
+            }
         }
-        colour *= 1.0f / static_cast<float>(mSettings.SamplesPerPixel);
-        colour.Clamp(0.0f, 0.9999f);
 
-        mCamera.GetViewport().SetPixel(index, colour[0], colour[1], colour[2]);
+        write();
     };
 
     const auto start = CurrentTime();
 
     // Render
-    const Size buckets = static_cast<Size>(mCamera.GetViewport().Area());
-    ThreadPool::RunWithCallback(job, [&]() { save(mCamera.GetViewport().GetPixels(), path); std::this_thread::sleep_for(std::chrono::seconds(2)); }, buckets);
+    if (mSettings.Adaptive && mSettings.Mode != Integrator::Wavefront)
+    {
+        RenderAdaptive(tiles, [&]() { save(viewport.GetPixels(), path); });
+    }
+    else if (mSettings.Progressive && mSettings.Mode != Integrator::Wavefront)
+    {
+        RenderProgressive(tiles, [&]() { save(viewport.GetPixels(), path); });
+    }
+    else
+    {
+        ThreadPool::RunWithCallback(job, [&]() { save(viewport.GetPixels(), path); }, tiles.size(), 1u);
+    }
 
     const auto end = CurrentTime();
     LOG_INFO("Start: ", start.count());
     LOG_INFO("End: ", end.count());
     LOG_INFO("Taken: ", (end.count() - start.count()));
 
-    return mCamera.GetViewport();
+    return viewport;
+}
+
+Vector3 RayTracer::Sample(const Size index, const Size sample) const
+{
+    // Adaptive pixels may take up to MaxSamples, every sample of every pixel gets its own seed.
+    const Size stride = mSettings.Adaptive ? std::max(mSettings.SamplesPerPixel, AdaptiveMaximum(mSettings)) : mSettings.SamplesPerPixel;
+    SeedRandom((static_cast<std::uint64_t>(index) * stride) + sample, mSettings.Seed);
+
+    // Every Random call of the sample takes the next dimension of the pixel's sample stream.
+    thread_local std::unique_ptr<Sampler> sampler;
+    thread_local SamplerType type = SamplerType::Independent;
+    if (mSettings.Sampling != SamplerType::Independent)
+    {
+        if (!sampler || type != mSettings.Sampling)
+        {
+            sampler = CreateSampler(mSettings.Sampling);
+            type = mSettings.Sampling;
+        }
+        sampler->Start(index, sample, stride, mSettings.Seed);
+        SetThreadSampler(sampler.get());
+    }
+
+    Vector3 colour;
+    const auto ray = mCamera.CreateRay(index);
+    if (mSettings.Mode == Integrator::Path)
+    {
+        colour = TracePath(ray, IntersectClosest(mScene.get().Hierarchy, ray));
+    }
+    else
+    {
+        colour = Trace(ray).SurfaceColour;
+    }
+    SetThreadSampler(nullptr);
+    return colour;
+}
+
+void RayTracer::RenderAdaptive(const std::vector<Tile>& tiles, const std::function<void()>& save)
+{
+    auto& viewport = mCamera.GetViewport();
+    const Size area = viewport.Area();
+
+    // Sum of the colours, running mean and sum of squared differences of the luminance, and
+    // the samples taken and wanted by every pixel.
+    std::vector<Vector3> sums(area);
+    std::vector<float> means(area, 0.0f);
+    std::vector<float> squares(area, 0.0f);
+    std::vector<Size> counts(area, 0u);
+    std::vector<Size> targets(area, 0u);
+
+    const Size maximum = AdaptiveMaximum(mSettings);
+    const Size minimum = std::clamp(mSettings.MinSamples, Size(2u), maximum);
+    std::fill(targets.begin(), targets.end(), minimum);
+
+    // Each round brings every pixel of a tile up to its target and shows the result.
+    auto job = [&](const Size i) -> void
+    {
+        thread_local std::vector<Vector3> colours;
+        const auto& tile = tiles[i];
+        colours.resize(tile.Area());
+
+        for (Size row = 0; row < tile.Height; ++row)
+        {
+            for (Size column = 0; column < tile.Width; ++column)
+            {
+                const Size index = viewport.Index(tile.X + column, tile.Y + row);
+                while (counts[index] < targets[index])
+                {
+                    const auto colour = Sample(index, counts[index]);
+                    sums[index] += colour;
+
+                    const float luminance = Luminance(colour);
+                    const float delta = luminance - means[index];
+                    means[index] += delta / static_cast<float>(++counts[index]);
+                    squares[index] += delta * (luminance - means[index]);
+                }
+
+                auto colour = sums[index] * (1.0f / static_cast<float>(counts[index]));
+                colour.Clamp(0.0f, 0.9999f);
+                colours[(row * tile.Width) + column] = colour;
+                mSampleCounts.Set(tile.X + column, tile.Y + row, counts[index]);
+            }
+        }
+
+        viewport.SetTile(tile, colours);
+    };
+
+    std::vector<float> errors(area, 0.0f);
+    std::vector<Size> noisy;
+    Size budget = (area * mSettings.SamplesPerPixel) - std::min(area * mSettings.SamplesPerPixel, area * minimum);
+    while (true)
+    {
+        ThreadPool::RunWithCallback(job, save, tiles.size(), 1u);
+
+        // Samples the converged pixels did not need go to the noisiest ones, a batch each per round.
+        noisy.clear();
+        for (Size index = 0; index < area; ++index)
+        {
+            const float n = static_cast<float>(counts[index]);
+            errors[index] = std::sqrt(squares[index] / ((n - 1.0f) * n));
+            if (counts[index] < maximum && errors[index] > mSettings.ErrorThreshold)
+            {
+                noisy.push_back(index);
+            }
+        }
+
+        if (budget == 0u || noisy.empty())
+        {
+            break;
+        }
+
+        std::stable_sort(noisy.begin(), noisy.end(), [&](const Size a, const Size b) { return errors[a] > errors[b]; });
+        for (const auto index : noisy)
+        {
+            const Size samples = std::min({ minimum, maximum - counts[index], budget });
+            targets[index] += samples;
+            budget -= samples;
+            if (budget == 0u)
+            {
+                break;
+            }
+        }
+    }
+}
+
+void RayTracer::RenderProgressive(const std::vector<Tile>& tiles, const std::function<void()>& save)
+{
+    auto& viewport = mCamera.GetViewport();
+    const Size area = viewport.Area();
+    std::vector<Vector3> accumulation(area);
+
+    const auto deadline = std::chrono::steady_clock::now() + mSettings.TimeBudget;
+    const auto expired = [&]()
+    {
+        return mSettings.TimeBudget.count() > 0 && std::chrono::steady_clock::now() >= deadline;
+    };
+
+    // The first pass always finishes so the image has no holes, even if it takes more than the
+    // sample budget. After that, tiles started after the deadline are skipped, so a pass can end
+    // with some tiles a pass behind. Every pixel is shown as the average of the samples it has.
+    const Size passSamples = std::max(mSettings.PassSamples, Size(1u));
+    Size taken = 0u;
+    for (Size first = 0; first < mSettings.SamplesPerPixel && (first == 0u || !expired()); first += passSamples)
+    {
+        const Size last = std::min(first + passSamples, mSettings.SamplesPerPixel);
+        if (first > 0u && mSettings.SampleBudget > 0u && taken + (area * (last - first)) > mSettings.SampleBudget)
+        {
+            break;
+        }
+
+        ThreadPool::Run([&](const Size i)
+        {
+            if (first > 0u && expired())
+            {
+                return;
+            }
+
+            const auto& tile = tiles[i];
+            for (Size row = 0; row < tile.Height; ++row)
+            {
+                for (Size column = 0; column < tile.Width; ++column)
+                {
+                    const Size index = viewport.Index(tile.X + column, tile.Y + row);
+                    for (Size s = first; s < last; ++s)
+                    {
+                        accumulation[index] += Sample(index, s);
+                    }
+                    mSampleCounts.Set(tile.X + column, tile.Y + row, last);
+                }
+            }
+        }, tiles.size(), 1u);
+
+        // Only finished passes reach the viewport, so a saved image is always consistent.
+        taken = 0u;
+        for (Size index = 0; index < area; ++index)
+        {
+            const Size count = mSampleCounts[index];
+            if (count == 0u)
+            {
+                continue;
+            }
+
+            auto colour = accumulation[index] * (1.0f / static_cast<float>(count));
+            colour.Clamp(0.0f, 0.9999f);
+            viewport.SetPixel(index, colour[0], colour[1], colour[2]);
+            taken += count;
+        }
+        save();
+    }
 }
 
 Intersection RayTracer::Trace(const Ray& ray, const Size depth) const
@@ -59,22 +312,25 @@ Intersection RayTracer::Trace(const Ray& ray, const Size depth) const
         return Intersection();
     }
 
-    const auto intersections = IntersectScene(mScene.get().Objects, ray, true);
+    return Shade(ray, IntersectClosest(mScene.get().Hierarchy, ray), depth);
+}
 
-    if (intersections.empty())
+Intersection RayTracer::Shade(const Ray& ray, const HitRecord& closest, const Size depth) const
+{
+    if (!closest)
     {
         return { false, Vector3(), mSettings.BackgroundColour, nullptr };
     }
 
-    auto intersection = intersections.front();
+    Intersection intersection = { true, closest.Position(ray), Vector3(), closest.Object, closest.Distance, closest.Instance, closest.Primitive };
     const auto object = intersection.Object;
-    const auto normal = object->CalculateNormal(intersection.Position);
+    const auto normal = intersection.Normal();
     const auto hit = intersection.Position + (normal * 0.0001f);
 
     Vector3 direct = 0.0f;
     Vector3 indirect = 0.0f;
 
-    direct += object->Material.BSDF(ray, normal, hit, mScene.get().Objects, mScene.get().Lights);
+    direct += object->Material.BSDF(ray, normal, hit, mScene.get().Hierarchy, mScene.get().Lights);
 
     if (depth < mSettings.MaxGIDepth)
     {
@@ -87,6 +343,330 @@ Intersection RayTracer::Trace(const Ray& ray, const Size depth) const
     return intersection;
 }
 
+Vector3 RayTracer::TracePath(Ray ray, HitRecord closest) const
+{
+    const auto& scene = mScene.get();
+    Vector3 colour = 0.0f;
+    Vector3 throughput = 1.0f;
+
+    for (Size depth = 0; ; ++depth)
+    {
+        if (!closest)
+        {
+            colour += throughput * mSettings.BackgroundColour;
+            break;
+        }
+
+        const auto& material = closest.Object->Material;
+        const auto position = closest.Position(ray);
+        const auto normal = closest.Normal(position);
+        const auto hit = position + (normal * 0.0001f);
+
+        const auto direct = material.BSDF(ray, normal, hit, scene.Hierarchy, scene.Lights);
+        colour += throughput * (direct / PI) * material.Albedo;
+
+        if (depth >= mSettings.MaxGIDepth || depth >= mSettings.MaxDepth)
+        {
+            break;
+        }
+
+        // A single bounce weighted like each of the SecondryBounces rays in GlobalIllumination,
+        // so the estimate matches Trace while the work grows linearly with depth.
+        const float random1 = Random();
+        const float random2 = Random();
+        const auto axis = Transform(normal, (ray.GetOrigin() - hit).Normalized(), hit, false);
+        const Vector3 direction = SampleHemisphere(random1, random2).MatrixMultiply(axis.GetAxis());
+        throughput *= material.Albedo * ((2.0f * random1) / static_cast<float>(depth + 1u));
+
+        // Paths carrying little light are ended at random, survivors are weighted up to keep the
+        // estimate unbiased.
+        if (depth + 1u >= mSettings.RouletteDepth)
+        {
+            const float survival = std::min(std::max({ throughput[0], throughput[1], throughput[2] }), 1.0f);
+            if (survival <= 0.0f || Random() >= survival)
+            {
+                break;
+            }
+            throughput *= 1.0f / survival;
+        }
+
+        ray = Ray(axis.GetPosition(), direction);
+        closest = IntersectClosest(scene.Hierarchy, ray);
+    }
+    return colour;
+}
+
+void RayTracer::TracePackets(const Tile& tile, std::vector<Vector3>& colours) const
+{
+    thread_local RayPacket packet;
+    std::array<HitRecord, RayPacket::Width> hits;
+    // Random state after each camera ray, so shading draws the same numbers as Trace would.
+    std::array<RandomGenerator, RayPacket::Width> generators;
+    std::array<Size, RayPacket::Width> pixels;
+
+    const auto& viewport = mCamera.GetViewport();
+    std::fill(colours.begin(), colours.end(), Vector3());
+
+    for (Size y = 0; y < tile.Height; y += PacketSide)
+    {
+        for (Size x = 0; x < tile.Width; x += PacketSide)
+        {
+            const Size rows = std::min(PacketSide, tile.Height - y);
+            const Size columns = std::min(PacketSide, tile.Width - x);
+
+            for (Size s = 0; s < mSettings.SamplesPerPixel; ++s)
+            {
+                packet.Clear();
+                for (Size row = y; row < y + rows; ++row)
+                {
+                    for (Size column = x; column < x + columns; ++column)
+                    {
+                        const Size index = viewport.Index(tile.X + column, tile.Y + row);
+                        SeedRandom((static_cast<std::uint64_t>(index) * mSettings.SamplesPerPixel) + s, mSettings.Seed);
+
+                        pixels[packet.Count()] = (row * tile.Width) + column;
+                        packet.Push(mCamera.CreateRay(index));
+                        generators[packet.Count() - 1u] = ThreadRandomGenerator();
+                    }
+                }
+
+                mScene.get().Hierarchy.Closest(packet, hits);
+
+                for (Size i = 0; i < packet.Count(); ++i)
+                {
+                    ThreadRandomGenerator() = generators[i];
+                    colours[pixels[i]] += mSettings.Mode == Integrator::Path ?
+                        TracePath(packet.Rays[i], hits[i]) :
+                        Shade(packet.Rays[i], hits[i], 0u).SurfaceColour;
+                }
+            }
+        }
+    }
+
+    for (auto& colour : colours)
+    {
+        colour *= 1.0f / static_cast<float>(mSettings.SamplesPerPixel);
+        colour.Clamp(0.0f, 0.9999f);
+    }
+}
+
+void RayQueue::Push(const Ray& ray, const Vector3& weight, const std::uint32_t pixel, const RandomGenerator& generator)
+{
+    Origins.push_back(ray.GetOrigin());
+    Directions.push_back(ray.GetDirection());
+    Weights.push_back(weight);
+    Pixels.push_back(pixel);
+    Generators.push_back(generator);
+}
+
+void RayQueue::Clear()
+{
+    Origins.clear();
+    Directions.clear();
+    Weights.clear();
+    Pixels.clear();
+    Generators.clear();
+}
+
+void RayTracer::TraceWavefront(const Tile& tile, std::vector<Vector3>& colours) const
+{
+    // One queue per bounce, a queue is flushed through every stage once it holds WavefrontSize rays.
+    thread_local std::vector<RayQueue> queues;
+    queues.resize(std::max(queues.size(), mSettings.MaxGIDepth + 1u));
+    for (auto& queue : queues)
+    {
+        queue.Clear();
+    }
+
+    const auto& viewport = mCamera.GetViewport();
+    const Vector3 weight(1.0f / static_cast<float>(mSettings.SamplesPerPixel));
+    std::fill(colours.begin(), colours.end(), Vector3());
+
+    // Generate: camera rays in blocks of pixels so neighbouring rays are coherent.
+    for (Size y = 0; y < tile.Height; y += PacketSide)
+    {
+        for (Size x = 0; x < tile.Width; x += PacketSide)
+        {
+            for (Size s = 0; s < mSettings.SamplesPerPixel; ++s)
+            {
+                for (Size row = y; row < std::min(y + PacketSide, tile.Height); ++row)
+                {
+                    for (Size column = x; column < std::min(x + PacketSide, tile.Width); ++column)
+                    {
+                        const Size index = viewport.Index(tile.X + column, tile.Y + row);
+                        SeedRandom((static_cast<std::uint64_t>(index) * mSettings.SamplesPerPixel) + s, mSettings.Seed);
+                        const auto ray = mCamera.CreateRay(index);
+                        queues[0].Push(ray, weight, static_cast<std::uint32_t>((row * tile.Width) + column), ThreadRandomGenerator());
+                    }
+                }
+
+                if (queues[0].Count() >= mSettings.WavefrontSize)
+                {
+                    Flush(queues, 0u, colours);
+                }
+            }
+        }
+    }
+    Flush(queues, 0u, colours);
+
+    for (auto& colour : colours)
+    {
+        colour.Clamp(0.0f, 0.9999f);
+    }
+}
+
+void RayTracer::Flush(std::vector<RayQueue>& queues, const Size depth, std::vector<Vector3>& colours) const
+{
+    auto& queue = queues[depth];
+    if (queue.Count() == 0u)
+    {
+        return;
+    }
+
+    Extend(queue, depth);
+    Connect(queue);
+
+    // Shading spawns SecondryBounces rays per hit into the next queue, which is flushed in
+    // between slices so it never grows far beyond WavefrontSize.
+    const bool spawns = depth < mSettings.MaxGIDepth && depth < mSettings.MaxDepth;
+    auto& next = queues[std::min(depth + 1u, queues.size() - 1u)];
+    const Size slice = spawns ? std::max(mSettings.WavefrontSize / std::max(mSettings.SecondryBounces, Size(1u)), Size(1u)) : queue.Count();
+    for (Size start = 0; start < queue.Count(); start += slice)
+    {
+        if (spawns && next.Count() >= mSettings.WavefrontSize)
+        {
+            Flush(queues, depth + 1u, colours);
+        }
+        Shade(queue, start, std::min(start + slice, queue.Count()), depth, next);
+    }
+
+    Accumulate(queue, colours);
+    queue.Clear();
+
+    if (spawns)
+    {
+        Flush(queues, depth + 1u, colours);
+    }
+}
+
+void RayTracer::Extend(RayQueue& queue, const Size depth) const
+{
+    const auto& bvh = mScene.get().Hierarchy;
+    const Size count = queue.Count();
+    queue.Hits.resize(count);
+
+    Size i = 0u;
+    if (depth == 0u && mSettings.PacketTracing)
+    {
+        // Camera rays were generated in blocks of RayPacket::Width.
+        thread_local RayPacket packet;
+        std::array<HitRecord, RayPacket::Width> hits;
+        for (; i + RayPacket::Width <= count; i += RayPacket::Width)
+        {
+            packet.Clear();
+            for (Size j = i; j < i + RayPacket::Width; ++j)
+            {
+                packet.Push(queue.GetRay(j));
+            }
+            bvh.Closest(packet, hits);
+            std::copy(hits.begin(), hits.end(), queue.Hits.begin() + i);
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        queue.Hits[i] = IntersectClosest(bvh, queue.GetRay(i));
+    }
+
+    // Shade rays that hit the same object, and so the same material, one after another.
+    queue.Order.resize(count);
+    std::iota(queue.Order.begin(), queue.Order.end(), 0u);
+    std::stable_sort(queue.Order.begin(), queue.Order.end(), [&](const std::uint32_t a, const std::uint32_t b)
+    {
+        return std::less<const Object*>()(queue.Hits[a].Object, queue.Hits[b].Object);
+    });
+}
+
+void RayTracer::Connect(RayQueue& queue) const
+{
+    const auto& scene = mScene.get();
+    queue.Positions.resize(queue.Count());
+    queue.Normals.resize(queue.Count());
+    queue.Shadows.resize(queue.Count());
+
+    for (const auto i : queue.Order)
+    {
+        const auto& hit = queue.Hits[i];
+        if (!hit)
+        {
+            continue;
+        }
+
+        const auto position = hit.Position(queue.GetRay(i));
+        queue.Normals[i] = hit.Normal(position);
+        queue.Positions[i] = position + (queue.Normals[i] * 0.0001f);
+
+        ThreadRandomGenerator() = queue.Generators[i];
+        queue.Shadows[i] = hit.Object->Material.Shadow(queue.Positions[i], scene.Hierarchy, scene.Lights);
+        queue.Generators[i] = ThreadRandomGenerator();
+    }
+}
+
+void RayTracer::Shade(RayQueue& queue, const Size start, const Size end, const Size depth, RayQueue& next) const
+{
+    const auto& scene = mScene.get();
+    const bool spawns = depth < mSettings.MaxGIDepth && depth < mSettings.MaxDepth;
+    const float scale = 2.0f / static_cast<float>(mSettings.SecondryBounces * (depth + 1u));
+    queue.Radiance.resize(queue.Count());
+
+    for (Size k = start; k < end; ++k)
+    {
+        const std::uint32_t i = queue.Order[k];
+        const auto& hit = queue.Hits[i];
+        if (!hit)
+        {
+            queue.Radiance[i] = queue.Weights[i] * mSettings.BackgroundColour;
+            continue;
+        }
+
+        const auto ray = queue.GetRay(i);
+        const auto& material = hit.Object->Material;
+        const auto& normal = queue.Normals[i];
+        const auto& position = queue.Positions[i];
+
+        ThreadRandomGenerator() = queue.Generators[i];
+        const auto direct = material.BSDF(ray, normal, position, scene.Hierarchy, scene.Lights, queue.Shadows[i]);
+        queue.Radiance[i] = queue.Weights[i] * (direct / PI) * material.Albedo;
+
+        if (!spawns)
+        {
+            continue;
+        }
+
+        // The indirect term of Trace, each bounce carries its share of the weight instead of
+        // returning a colour to be averaged.
+        auto& generator = ThreadRandomGenerator();
+        const auto axis = Transform(normal, (ray.GetOrigin() - position).Normalized(), position, false);
+        for (Size b = 0; b < mSettings.SecondryBounces; ++b)
+        {
+            const float random1 = generator.NextFloat();
+            const float random2 = generator.NextFloat();
+            const Vector3 direction = SampleHemisphere(random1, random2).MatrixMultiply(axis.GetAxis());
+            const std::uint64_t high = generator.Next();
+            const std::uint64_t seed = (high << 32u) | generator.Next();
+            next.Push(Ray(axis.GetPosition(), direction), queue.Weights[i] * material.Albedo * (random1 * scale), queue.Pixels[i], RandomGenerator(seed, mSettings.Seed));
+        }
+    }
+}
+
+void RayTracer::Accumulate(const RayQueue& queue, std::vector<Vector3>& colours) const
+{
+    for (Size i = 0; i < queue.Count(); ++i)
+    {
+        colours[queue.Pixels[i]] += queue.Radiance[i];
+    }
+}
+
 Vector3 RayTracer::GlobalIllumination(const Ray& ray, const Vector3& normal, const Vector3& hit, const Size depth) const
 {
     Vector3 indirect = 0.0f;
@@ -0,0 +1,193 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+
+namespace
+{
+	constexpr std::array<std::uint32_t, 32> Primes = {
+		2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u, 41u, 43u, 47u, 53u,
+		59u, 61u, 67u, 71u, 73u, 79u, 83u, 89u, 97u, 101u, 103u, 107u, 109u, 113u, 127u, 131u };
+
+	// Largest float below one, sequences in fixed point can round up to one otherwise.
+	constexpr float OneMinusEpsilon = 0x1.fffffep-1f;
+
+	std::uint32_t Hash(std::uint32_t value, const std::uint32_t key)
+	{
+		value ^= key * 0x9E3779B9u;
+		value ^= value >> 16u;
+		value *= 0x85EBCA6Bu;
+		value ^= value >> 13u;
+		value *= 0xC2B2AE35u;
+		return value ^ (value >> 16u);
+	}
+
+	std::uint32_t ReverseBits(std::uint32_t value)
+	{
+		value = (value << 16u) | (value >> 16u);
+		value = ((value & 0x00FF00FFu) << 8u) | ((value & 0xFF00FF00u) >> 8u);
+		value = ((value & 0x0F0F0F0Fu) << 4u) | ((value & 0xF0F0F0F0u) >> 4u);
+		value = ((value & 0x33333333u) << 2u) | ((value & 0xCCCCCCCCu) >> 2u);
+		return ((value & 0x55555555u) << 1u) | ((value & 0xAAAAAAAAu) >> 1u);
+	}
+
+	// Owen scramble of a 32 bit fixed point number, each bit is flipped depending on the bits
+	// above it (Laine and Karras hash, applied to the reversed bits as in Burley 2020).
+	std::uint32_t OwenScramble(std::uint32_t value, const std::uint32_t seed)
+	{
+		value = ReverseBits(value);
+		value += seed;
+		value ^= value * 0x6C50B47Cu;
+		value ^= value * 0xB82F1E52u;
+		value ^= value * 0xC7AFE638u;
+		value ^= value * 0x8D22F6E6u;
+		return ReverseBits(value);
+	}
+
+	// Element index of a random permutation of [0, count) chosen by seed (Kensler 2013).
+	std::uint32_t Permute(std::uint32_t index, const std::uint32_t count, const std::uint32_t seed)
+	{
+		std::uint32_t mask = count - 1u;
+		mask |= mask >> 1u;
+		mask |= mask >> 2u;
+		mask |= mask >> 4u;
+		mask |= mask >> 8u;
+		mask |= mask >> 16u;
+		do
+		{
+			index ^= seed;
+			index *= 0xE170893Du;
+			index ^= seed >> 16u;
+			index ^= (index & mask) >> 4u;
+			index ^= seed >> 8u;
+			index *= 0x0929EB3Fu;
+			index ^= seed >> 23u;
+			index ^= (index & mask) >> 1u;
+			index *= 1u | (seed >> 27u);
+			index *= 0x6935FA69u;
+			index ^= (index & mask) >> 11u;
+			index *= 0x74DCB303u;
+			index ^= (index & mask) >> 2u;
+			index *= 0x9E501CC3u;
+			index ^= (index & mask) >> 2u;
+			index *= 0xC860A3DFu;
+			index &= mask;
+			index ^= index >> 5u;
+		} while (index >= count);
+		return (index + seed) % count;
+	}
+
+	// Second dimension of the Sobol sequence, the first is the bit reversed index.
+	std::uint32_t Sobol(std::uint32_t index)
+	{
+		std::uint32_t result = 0u;
+		for (std::uint32_t direction = 1u << 31u; index != 0u; index >>= 1u, direction ^= direction >> 1u)
+		{
+			if ((index & 1u) != 0u)
+			{
+				result ^= direction;
+			}
+		}
+		return result;
+	}
+
+	float ToFloat(const std::uint32_t value)
+	{
+		return static_cast<float>(value >> 8u) * (1.0f / 16777216.0f);
+	}
+
+	float RadicalInverse(Size index, const std::uint32_t base)
+	{
+		const float inverse = 1.0f / static_cast<float>(base);
+		float scale = inverse;
+		float result = 0.0f;
+		while (index > 0u)
+		{
+			result += static_cast<float>(index % base) * scale;
+			index /= base;
+			scale *= inverse;
+		}
+		return std::min(result, OneMinusEpsilon);
+	}
+
+	Sampler*& CurrentSampler()
+	{
+		thread_local Sampler* sampler = nullptr;
+		return sampler;
+	}
+}
+
+void Sampler::Start(const std::uint64_t pixel, const Size index, const Size count, const std::uint64_t seed)
+{
+	m_scramble = Hash(Hash(static_cast<std::uint32_t>(pixel), static_cast<std::uint32_t>(pixel >> 32u)), static_cast<std::uint32_t>(seed));
+	m_index = index;
+	m_count = std::max(count, Size(1u));
+	m_dimension = 0u;
+	m_generator.Seed((pixel * m_count) + index, seed);
+}
+
+float IndependentSampler::Next()
+{
+	++m_dimension;
+	return m_generator.NextFloat();
+}
+
+float StratifiedSampler::Next()
+{
+	const auto count = static_cast<std::uint32_t>(m_count);
+	const auto stratum = Permute(static_cast<std::uint32_t>(m_index % m_count), count, Hash(m_scramble, static_cast<std::uint32_t>(m_dimension++)));
+	return std::min((static_cast<float>(stratum) + m_generator.NextFloat()) / static_cast<float>(count), OneMinusEpsilon);
+}
+
+float SobolSampler::Next()
+{
+	// Dimensions are drawn in pairs of the two dimensional Sobol sequence, each pair with its own
+	// shuffle of the sample order so that pairs are not correlated with each other.
+	const auto pair = static_cast<std::uint32_t>(m_dimension / 2u);
+	if ((m_dimension++ % 2u) == 1u)
+	{
+		return m_pending;
+	}
+
+	const auto seed = Hash(m_scramble, pair);
+	const auto index = Permute(static_cast<std::uint32_t>(m_index % m_count), static_cast<std::uint32_t>(m_count), seed);
+	m_pending = ToFloat(OwenScramble(Sobol(index), Hash(seed, 2u)));
+	return ToFloat(OwenScramble(ReverseBits(index), Hash(seed, 1u)));
+}
+
+float HaltonSampler::Next()
+{
+	const auto dimension = m_dimension++;
+	if (dimension >= Primes.size())
+	{
+		return m_generator.NextFloat();
+	}
+
+	const float offset = ToFloat(Hash(m_scramble, static_cast<std::uint32_t>(dimension)));
+	const float value = RadicalInverse(m_index, Primes[dimension]) + offset;
+	return std::min(value >= 1.0f ? value - 1.0f : value, OneMinusEpsilon);
+}
+
+std::unique_ptr<Sampler> Renderer::CreateSampler(const SamplerType type)
+{
+	switch (type)
+	{
+	case SamplerType::Stratified:
+		return std::make_unique<StratifiedSampler>();
+	case SamplerType::Sobol:
+		return std::make_unique<SobolSampler>();
+	case SamplerType::Halton:
+		return std::make_unique<HaltonSampler>();
+	default:
+		return std::make_unique<IndependentSampler>();
+	}
+}
+
+Sampler* Renderer::ThreadSampler()
+{
+	return CurrentSampler();
+}
+
+void Renderer::SetThreadSampler(Sampler* sampler)
+{
+	CurrentSampler() = sampler;
+}
\ No newline at end of file
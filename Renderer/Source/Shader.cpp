@@ -28,25 +28,46 @@ Vector3 Shader::BSDF(
 	const Ray& ray, 
 	const Vector3& normal, 
 	const Vector3& hit, 
-	const std::vector<std::shared_ptr<Object>>& objects, 
+	const BVH& bvh, 
 	const std::vector<std::shared_ptr<Light>>& lights) const
 {
-	return BRDF(ray, normal, hit, objects, lights);
+	return BRDF(ray, normal, hit, bvh, lights);
+}
+
+Vector3 Shader::BSDF(
+	const Ray& ray,
+	const Vector3& normal,
+	const Vector3& hit,
+	const BVH& bvh,
+	const std::vector<std::shared_ptr<Light>>& lights,
+	const float shadow) const
+{
+	return BRDF(ray, normal, hit, bvh, lights, shadow);
 }
 
 Vector3 Shader::BRDF(
 	const Ray& ray, 
 	const Vector3& normal, 
 	const Vector3& hit, 
-	const std::vector<std::shared_ptr<Object>>& objects, 
+	const BVH& bvh, 
 	const std::vector<std::shared_ptr<Light>>& lights) const
+{
+	return BRDF(ray, normal, hit, bvh, lights, Shadow(hit, bvh, lights));
+}
+
+Vector3 Shader::BRDF(
+	const Ray& ray,
+	const Vector3& normal,
+	const Vector3& hit,
+	const BVH& bvh,
+	const std::vector<std::shared_ptr<Light>>& lights,
+	const float shadow) const
 {
 	const auto viewDirection = (ray.GetOrigin() - hit).Normalized();
 	const auto reflection = Ray::Reflection(normal, viewDirection);
 	const auto NdotV = normal.DotProduct(viewDirection);
 	const auto F0 = Vector3::Mix(Vector3(0.04f), Albedo, Metalness);
 
-	const float shadow = Shadow(hit, objects, lights);
 	if (shadow < 0.0001f)
 	{
 		return { 0.0f, 0.0f, 0.0f };
@@ -82,7 +103,7 @@ Vector3 Shader::BRDF(
 	}
 
 	const auto sceneReflections = SceneReflections(
-		ray.GetOrigin(), hit, normal, Roughness, ReflectionDepth, ReflectionSamples, objects);
+		ray.GetOrigin(), hit, normal, Roughness, ReflectionDepth, ReflectionSamples, bvh);
 
 	Vector3 Lo = 0.0f;
 	for (const auto& light : lights)
@@ -91,6 +112,12 @@ Vector3 Shader::BRDF(
 		samplingSettings.Roughness = Roughness;
 		samplingSettings.SamplerType = SamplerSettings::Sampler::SAMPLE_HEMISPHERE_GGX;
 
+		if (const auto area = std::dynamic_pointer_cast<Area>(light))
+		{
+			Lo += AreaLighting(*area, normal, viewDirection, hit, F0, bvh);
+			continue;
+		}
+
 		Vector3 L = 0.0f;
 		Size samples = light->Samples;
 		for (Size i = 0; i < samples; ++i)
@@ -98,9 +125,6 @@ Vector3 Shader::BRDF(
 			const auto lightSampleSpecular = light->Sampler(hit, reflection, normal, samplingSettings);
 			const auto lightDirection = lightSampleSpecular.IncomingRay.GetDirection();
 			auto lightColour = lightSampleSpecular.Colour;
-
-			const auto halfDirection = (viewDirection + lightDirection).Normalized();
-			const auto HdotV = halfDirection.DotProduct(viewDirection);
 			const auto NdotL = normal.DotProduct(lightDirection);
 
 			if (environment)
@@ -108,20 +132,7 @@ Vector3 Shader::BRDF(
 				lightColour += sceneReflections * 10.0f;
 			}
 			const auto radiance = light->Attenuation(lightColour, light->Intensity, lightSampleSpecular.Distance);
-
-			const auto NDF = Distribution(normal, halfDirection, Roughness);
-			const auto G = Geometry(normal, viewDirection, lightDirection, Roughness);
-			const auto F = Fresnel(std::max(HdotV, 0.0f), F0);
-
-			const auto nominator = F * NDF * G;
-			const auto denominator = 4.0f * std::max(NdotV, 0.0f) * std::max(NdotL, 0.0f);
-			const auto specular = nominator / std::max(denominator, 0.001f);
-
-			const auto kS = F;
-			auto kD = Vector3(1.0f) - kS;
-			kD *= 1.0f - Metalness;
-
-			L += (((kD * Albedo) / PI) + specular) * radiance * std::max(NdotL, 0.0f);
+			L += Reflectance(normal, viewDirection, lightDirection, F0) * radiance * std::max(NdotL, 0.0f);
 		}
 		L = L * (1.0f / float(samples));
 		Lo += L;
@@ -138,13 +149,13 @@ Vector3 Shader::BRDF(
 }
 
 float Shader::Shadow(const Vector3& hit,
-	const std::vector<std::shared_ptr<Object>>& objects,
+	const BVH& bvh,
 	const std::vector<std::shared_ptr<Light>>& lights) const
 {
 	float shadow = static_cast<float>(lights.size());
 	for (const auto& light : lights)
 	{
-		shadow -= light->Shadow(objects, hit);
+		shadow -= light->Shadow(bvh, hit);
 	}
 	const float fraction = (1.0f / static_cast<float>(lights.size()));
 	return (shadow * fraction);
@@ -157,7 +168,7 @@ Vector3 Shader::SceneReflections(
 	float roughness,
 	const Size depth,
 	const Size samples,
-	const std::vector<std::shared_ptr<Object>>& objects) const
+	const BVH& bvh) const
 {
 	auto colour = Vector3();
 	for (Size i = 0; i < depth; ++i)
@@ -174,25 +185,139 @@ Vector3 Shader::SceneReflections(
 			const Vector3 hemisphereSampleToWorldSpace = hemisphereSample.MatrixMultiply(axis.GetAxis());
 			const auto ray = Ray(hit, hemisphereSampleToWorldSpace);
 
-			const auto intersections = IntersectScene(objects, ray, true);
-			if (intersections.empty())
+			const auto closest = IntersectClosest(bvh, ray);
+			if (!closest)
 			{
 				return Vector3();
 			}
 
-			intersection = intersections.front();
+			intersection = { true, closest.Position(ray), closest.Object->Material.Albedo, closest.Object, closest.Distance, closest.Instance, closest.Primitive };
 			colour += intersection.SurfaceColour;
 		}
-		const auto object = intersection.Object;
 		origin = hit;
 		hit = intersection.Position + (normal * 0.0001f);
-		normal = object->CalculateNormal(intersection.Position);
+		normal = intersection.Normal();
 		colour /= static_cast<float>(samples);
 	}
 
 	return colour;
 };
 
+Vector3 Shader::Reflectance(const Vector3& normal, const Vector3& view, const Vector3& lightDirection, const Vector3& F0) const
+{
+	const auto halfDirection = (view + lightDirection).Normalized();
+	const auto HdotV = halfDirection.DotProduct(view);
+	const auto NdotV = normal.DotProduct(view);
+	const auto NdotL = normal.DotProduct(lightDirection);
+
+	const auto NDF = Distribution(normal, halfDirection, Roughness);
+	const auto G = Geometry(normal, view, lightDirection, Roughness);
+	const auto F = Fresnel(std::max(HdotV, 0.0f), F0);
+
+	const auto nominator = F * NDF * G;
+	const auto denominator = 4.0f * std::max(NdotV, 0.0f) * std::max(NdotL, 0.0f);
+	const auto specular = nominator / std::max(denominator, 0.001f);
+
+	const auto kS = F;
+	auto kD = Vector3(1.0f) - kS;
+	kD *= 1.0f - Metalness;
+
+	return ((kD * Albedo) / PI) + specular;
+}
+
+Vector3 Shader::AreaLighting(
+	const Area& light,
+	const Vector3& normal,
+	const Vector3& view,
+	const Vector3& hit,
+	const Vector3& F0,
+	const BVH& bvh) const
+{
+	// Directions from the reflectance are split evenly between a uniform hemisphere for the
+	// diffuse part and GGX half vectors for the specular part.
+	constexpr float specularChance = 0.5f;
+	constexpr float hemispherePdf = 1.0f / (2.0f * PI);
+	const float roughness = std::max(Roughness, 0.01f);
+	const auto axis = Transform(normal, std::abs(normal[1]) < 0.999f ? Y_AXIS : X_AXIS, hit, false);
+
+	const auto reflectancePdf = [&](const Vector3& direction) -> float
+	{
+		return ((1.0f - specularChance) * hemispherePdf) + (specularChance * SpecularPdf(normal, view, direction, roughness));
+	};
+
+	// The shadow ray stops just short of the light in case its geometry is part of the scene.
+	const auto visibility = [&](const Vector3& direction, const float distance) -> float
+	{
+		return IsOccluded(bvh, Ray(hit, direction, 0.0f, distance * 0.999f)) ? 1.0f - light.ShadowIntensity : 1.0f;
+	};
+
+	// Every pair takes a point on the light and a direction from the reflectance, each weighted
+	// with the power heuristic so the strategy that is better for a direction dominates it. Half
+	// as many pairs as the light has Samples keeps the number of shadow rays the same.
+	const Size pairs = std::max(light.Samples / 2u, Size(1u));
+	Vector3 L = 0.0f;
+	for (Size i = 0; i < pairs; ++i)
+	{
+		const float random1 = Random();
+		const float random2 = Random();
+		const auto lightSample = light.SampleArea(hit, random1, random2);
+		const auto lightDirection = lightSample.IncomingRay.GetDirection();
+		const float lightNdotL = normal.DotProduct(lightDirection);
+		if (lightSample.Pdf > 0.0f && lightNdotL > 0.0f)
+		{
+			const float pdf = reflectancePdf(lightDirection);
+			const float weight = (lightSample.Pdf * lightSample.Pdf) / ((lightSample.Pdf * lightSample.Pdf) + (pdf * pdf));
+			const float scale = (lightNdotL * weight * visibility(lightDirection, lightSample.Distance)) / lightSample.Pdf;
+			L += Reflectance(normal, view, lightDirection, F0) * lightSample.Colour * scale;
+		}
+
+		const float random3 = Random();
+		const float random4 = Random();
+		const float random5 = Random();
+		Vector3 direction;
+		if (random5 < specularChance)
+		{
+			const Vector3 half = ImportanceSampleHemisphereGGX(random3, random4, roughness).MatrixMultiply(axis.GetAxis());
+			direction = Ray::Reflection(half.Normalized(), view);
+		}
+		else
+		{
+			direction = SampleHemisphere(random3, random4).MatrixMultiply(axis.GetAxis());
+		}
+		direction.Normalize();
+
+		const float NdotL = normal.DotProduct(direction);
+		float distance = 0.0f;
+		const float lightPdf = NdotL > 0.0f ? light.Pdf(Ray(hit, direction), distance) : 0.0f;
+		if (lightPdf > 0.0f)
+		{
+			const float pdf = reflectancePdf(direction);
+			const float weight = (pdf * pdf) / ((pdf * pdf) + (lightPdf * lightPdf));
+			const float scale = (NdotL * weight * visibility(direction, distance)) / pdf;
+			L += Reflectance(normal, view, direction, F0) * light.Radiance() * scale;
+		}
+	}
+	return L * (1.0f / static_cast<float>(pairs));
+}
+
+float Shader::SpecularPdf(const Vector3& normal, const Vector3& view, const Vector3& direction, const float roughness) const
+{
+	const auto half = (view + direction).Normalized();
+	const float NdotH = normal.DotProduct(half);
+	const float HdotV = half.DotProduct(view);
+	if (NdotH <= 0.0f || HdotV <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// Unclamped GGX distribution, the density of the half vectors ImportanceSampleHemisphereGGX draws.
+	const float a = roughness * roughness;
+	const float a2 = a * a;
+	const float denom = (NdotH * NdotH * (a2 - 1.0f)) + 1.0f;
+	const float distribution = a2 / (PI * denom * denom);
+	return (distribution * NdotH) / (4.0f * HdotV);
+}
+
 Vector3 Shader::Fresnel(const float incidenceAngle, const Vector3& ior) const
 {
 	return ior + (Vector3(1.0f) - ior) * std::pow(1.0f - incidenceAngle, 5.0f);
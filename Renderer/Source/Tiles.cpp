@@ -0,0 +1,97 @@
+#include "Renderer.h"
+
+using namespace Renderer;
+
+namespace
+{
+    std::uint64_t SpreadBits(const std::uint32_t value)
+    {
+        std::uint64_t x = value;
+        x = (x | (x << 16u)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x << 8u)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x << 4u)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x << 2u)) & 0x3333333333333333ULL;
+        x = (x | (x << 1u)) & 0x5555555555555555ULL;
+        return x;
+    }
+}
+
+std::uint64_t Renderer::MortonIndex(const std::uint32_t x, const std::uint32_t y)
+{
+    return SpreadBits(x) | (SpreadBits(y) << 1u);
+}
+
+std::uint64_t Renderer::HilbertIndex(std::uint32_t x, std::uint32_t y, const std::uint32_t n)
+{
+    std::uint64_t index = 0u;
+    for (std::uint32_t s = n / 2u; s > 0u; s /= 2u)
+    {
+        const std::uint32_t rx = (x & s) > 0u ? 1u : 0u;
+        const std::uint32_t ry = (y & s) > 0u ? 1u : 0u;
+        index += static_cast<std::uint64_t>(s) * s * ((3u * rx) ^ ry);
+
+        // Rotate the quadrant so the curve stays continuous.
+        if (ry == 0u)
+        {
+            if (rx == 1u)
+            {
+                x = s - 1u - x;
+                y = s - 1u - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+std::vector<Tile> Renderer::CreateTiles(const Size columns, const Size rows, const Size tile_size, const TileOrder order)
+{
+    ASSERT(tile_size == 0u, "Tile size must be greater than zero.");
+
+    const Size tiles_x = (columns + tile_size - 1u) / tile_size;
+    const Size tiles_y = (rows + tile_size - 1u) / tile_size;
+
+    std::uint32_t n = 1u;
+    while (n < tiles_x || n < tiles_y)
+    {
+        n *= 2u;
+    }
+
+    std::vector<std::pair<std::uint64_t, Tile>> keyed;
+    keyed.reserve(tiles_x * tiles_y);
+    for (Size ty = 0; ty < tiles_y; ++ty)
+    {
+        for (Size tx = 0; tx < tiles_x; ++tx)
+        {
+            Tile tile;
+            tile.X = tx * tile_size;
+            tile.Y = ty * tile_size;
+            tile.Width = std::min(tile_size, columns - tile.X);
+            tile.Height = std::min(tile_size, rows - tile.Y);
+
+            const auto x = static_cast<std::uint32_t>(tx);
+            const auto y = static_cast<std::uint32_t>(ty);
+            std::uint64_t key = static_cast<std::uint64_t>(keyed.size());
+            if (order == TileOrder::Morton)
+            {
+                key = MortonIndex(x, y);
+            }
+            else if (order == TileOrder::Hilbert)
+            {
+                key = HilbertIndex(x, y, n);
+            }
+
+            keyed.emplace_back(key, tile);
+        }
+    }
+
+    std::sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<Tile> tiles;
+    tiles.reserve(keyed.size());
+    for (const auto& entry : keyed)
+    {
+        tiles.push_back(entry.second);
+    }
+    return tiles;
+}
\ No newline at end of file
@@ -3,12 +3,6 @@
 using namespace Renderer;
 using namespace Renderer::Math;
 
-namespace
-{
-    std::default_random_engine Generator;
-    std::uniform_real_distribution<float> Distribution(0, 1);
-}
-
 Transform::Transform(const Vector3& direction, const Vector3& up, const Vector3& position, const bool calculate_inverse) :
     m_axis(Matrix3()),
     m_position(position),
@@ -50,6 +44,108 @@ Vector3 Ray::Reflection(const Vector3& normal, const Vector3& direction)
     return normal * (2.0f * normal.DotProduct(direction)) - direction;
 }
 
+void BoundingBox::Expand(const Vector3& point)
+{
+    Min = Vector3::Min(Min, point);
+    Max = Vector3::Max(Max, point);
+}
+
+void BoundingBox::Expand(const BoundingBox& box)
+{
+    Min = Vector3::Min(Min, box.Min);
+    Max = Vector3::Max(Max, box.Max);
+}
+
+Vector3 BoundingBox::Centroid() const
+{
+    return (Min + Max) * 0.5f;
+}
+
+float BoundingBox::SurfaceArea() const
+{
+    if (!IsValid())
+    {
+        return 0.0f;
+    }
+    const auto extent = Max - Min;
+    return 2.0f * ((extent[0] * extent[1]) + (extent[1] * extent[2]) + (extent[2] * extent[0]));
+}
+
+Size BoundingBox::LongestAxis() const
+{
+    const auto extent = Max - Min;
+    if (extent[0] > extent[1] && extent[0] > extent[2])
+    {
+        return 0u;
+    }
+    return extent[1] > extent[2] ? 1u : 2u;
+}
+
+bool BoundingBox::Intersect(const Ray& ray, const float minDistance, const float maxDistance, float& distance) const
+{
+    const auto& origin = ray.GetOrigin();
+    const auto& inverseDirection = ray.GetInverseDirection();
+    const auto& sign = ray.GetSign();
+    const std::array<const Vector3*, 2> corners = { &Min, &Max };
+
+    float tmin = minDistance;
+    float tmax = maxDistance;
+    for (Size i = 0; i < 3; ++i)
+    {
+        tmin = std::max(tmin, ((*corners[sign[i]])[i] - origin[i]) * inverseDirection[i]);
+        tmax = std::min(tmax, ((*corners[1u - sign[i]])[i] - origin[i]) * inverseDirection[i]);
+    }
+    distance = tmin;
+    return tmin <= tmax;
+}
+
+Vector3 Intersection::Normal() const
+{
+    return Instance ? Instance->CalculateNormal(*Object, Primitive, Position) : Object->CalculateNormal(Position, Primitive);
+}
+
+Vector3 HitRecord::Normal(const Vector3& position) const
+{
+    return Instance ? Instance->CalculateNormal(*Object, Primitive, position) : Object->CalculateNormal(position, Primitive);
+}
+
+void RayPacket::Push(const Ray& ray)
+{
+    ASSERT(Rays.size() >= Width, "Ray packet is full.");
+
+    const Size i = Rays.size();
+    Rays.push_back(ray);
+
+    const auto& origin = ray.GetOrigin();
+    const auto& inverse = ray.GetInverseDirection();
+    OriginX[i] = origin[0];
+    OriginY[i] = origin[1];
+    OriginZ[i] = origin[2];
+    InverseX[i] = inverse[0];
+    InverseY[i] = inverse[1];
+    InverseZ[i] = inverse[2];
+    MinDistance[i] = ray.GetMinDistance();
+    MaxDistance[i] = ray.GetMaxDistance();
+
+    const bool finite = std::isfinite(inverse[0]) && std::isfinite(inverse[1]) && std::isfinite(inverse[2]);
+    if (i == 0u)
+    {
+        Coherent = finite;
+        MinInverse = inverse;
+        MaxInverse = inverse;
+        return;
+    }
+
+    const Ray& first = Rays.front();
+    Coherent = Coherent && finite && ray.GetSign() == first.GetSign() &&
+        origin[0] == first.GetOrigin()[0] && origin[1] == first.GetOrigin()[1] && origin[2] == first.GetOrigin()[2];
+    for (Size axis = 0; axis < 3; ++axis)
+    {
+        MinInverse[axis] = std::min(MinInverse[axis], inverse[axis]);
+        MaxInverse[axis] = std::max(MaxInverse[axis], inverse[axis]);
+    }
+}
+
 std::vector<Intersection> Renderer::IntersectScene(const std::vector<std::shared_ptr<Object>>& objects, const Ray& ray, bool checkAll)
 {
     std::vector<Intersection> intersections;
@@ -65,10 +161,9 @@ std::vector<Intersection> Renderer::IntersectScene(const std::vector<std::shared
             }
 
             intersections.push_back(intersect);
-            const float hitDistance = ray.GetOrigin().Distance(intersect.Position);
-            if (hitDistance < distance)
+            if (intersect.Distance < distance)
             {
-                distance = hitDistance;
+                distance = intersect.Distance;
                 // Only care if front element is the closest;
                 std::swap(intersections.front(), intersections.back());
             }
@@ -77,9 +172,48 @@ std::vector<Intersection> Renderer::IntersectScene(const std::vector<std::shared
     return intersections;
 }
 
+std::vector<Intersection> Renderer::IntersectScene(const BVH& bvh, const Ray& ray, bool checkAll)
+{
+    const auto intersection = bvh.Intersect(ray, checkAll);
+    if (!intersection.Hit)
+    {
+        return {};
+    }
+    return { intersection };
+}
+
+HitRecord Renderer::IntersectClosest(const BVH& bvh, const Ray& ray)
+{
+    return bvh.Closest(ray);
+}
+
+bool Renderer::IsOccluded(const BVH& bvh, const Ray& ray)
+{
+    return bvh.Occluded(ray);
+}
+
+RandomGenerator& Renderer::ThreadRandomGenerator()
+{
+    // Each thread gets its own stream, numbered in the order threads first ask for one. Numbers
+    // drawn before SeedRandom therefore depend on thread scheduling, only seeded draws are
+    // reproducible.
+    static std::atomic<std::uint64_t> streams = 0u;
+    thread_local RandomGenerator generator(0u, streams++);
+    return generator;
+}
+
+void Renderer::SeedRandom(const std::uint64_t seed, const std::uint64_t stream)
+{
+    ThreadRandomGenerator().Seed(seed, stream);
+}
+
 float Renderer::Random()
 {
-    return Distribution(Generator);
+    if (auto* sampler = ThreadSampler())
+    {
+        return sampler->Next();
+    }
+    return ThreadRandomGenerator().NextFloat();
 }
 
 Vector3 Renderer::SampleHemisphere(const float r1, const float r2)
@@ -23,6 +23,21 @@ void Viewport::SetPixel(const Size index, const float r, const float g, const fl
     m_pixels[2][index] = b;
 }
 
+void Viewport::SetTile(const Tile& tile, const std::vector<Vector3>& colours)
+{
+    for (Size row = 0; row < tile.Height; ++row)
+    {
+        const Size offset = Index(tile.X, tile.Y + row);
+        for (Size column = 0; column < tile.Width; ++column)
+        {
+            const auto& colour = colours[(row * tile.Width) + column];
+            m_pixels[0][offset + column] = colour[0];
+            m_pixels[1][offset + column] = colour[1];
+            m_pixels[2][offset + column] = colour[2];
+        }
+    }
+}
+
 Vector3 Viewport::GetPixelValue(const Size index) const
 {
     return { m_pixels[0][index] , m_pixels[1][index] , m_pixels[2][index] };
@@ -523,4 +523,1257 @@ TEST_F(RendererUnitTests, CubesTest)
 
 	const auto RenderBlockCityScene = RayTracer(Scene(objects, lights, camera), settings).Render(&SaveImage, "Render_Update.png");
 	SaveImage(RenderBlockCityScene.GetPixels(), "Render_Cubes.png");
-}
\ No newline at end of file
+}
+
+TEST_F(RendererUnitTests, BVHTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	for (Size i = 0; i < 200; ++i)
+	{
+		const Vector3 position = { (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f };
+		if (i % 3 == 0)
+		{
+			auto sphere = std::make_shared<Sphere>();
+			sphere->Radius = Random() + 0.1f;
+			sphere->XForm.SetPosition(position);
+			objects.push_back(sphere);
+		}
+		else if (i % 3 == 1)
+		{
+			auto cube = std::make_shared<Cube>();
+			cube->Width = Random() + 0.1f;
+			cube->Height = Random() + 0.1f;
+			cube->Length = Random() + 0.1f;
+			cube->XForm.SetPosition(position);
+			objects.push_back(cube);
+		}
+		else
+		{
+			const Vector3 direction = { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f };
+			objects.push_back(std::make_shared<Plane>(Plane(Random() + 0.5f, Random() + 0.5f, position, direction)));
+		}
+	}
+
+	// A low threshold so the parallel binning and subtree builds are exercised.
+	BVH::Settings parallelSettings;
+	parallelSettings.ParallelThreshold = 16u;
+	const BVH bvh(objects, parallelSettings);
+	ASSERT_FALSE(bvh.GetWideNodes().empty());
+
+	BVH::Settings binarySettings;
+	binarySettings.NodeLayout = BVH::Layout::Binary;
+	const BVH binary(objects, binarySettings);
+	ASSERT_TRUE(binary.GetWideNodes().empty());
+
+	for (Size i = 0; i < 2000; ++i)
+	{
+		const Vector3 origin = { (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f };
+		const Vector3 direction = { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f };
+		const Ray ray(origin, direction);
+
+		const auto linear = IntersectScene(objects, ray, true);
+		const auto hierarchy = IntersectScene(bvh, ray, true);
+		const auto closest = IntersectClosest(bvh, ray);
+		const auto binaryClosest = IntersectClosest(binary, ray);
+		ASSERT_EQ(linear.empty(), hierarchy.empty());
+		ASSERT_EQ(linear.empty(), !static_cast<bool>(closest));
+		ASSERT_EQ(linear.empty(), !static_cast<bool>(binaryClosest));
+		EXPECT_EQ(closest.Distance, binaryClosest.Distance);
+
+		const float maxDistance = Random() * 30.0f;
+		Ray shadow = ray;
+		shadow.SetInterval(0.0f, maxDistance);
+		EXPECT_EQ(!linear.empty() && linear.front().Distance < maxDistance, IsOccluded(bvh, shadow));
+		EXPECT_EQ(!linear.empty() && linear.front().Distance < maxDistance, IsOccluded(binary, shadow));
+		if (!linear.empty())
+		{
+			EXPECT_NEAR(origin.Distance(linear.front().Position), origin.Distance(hierarchy.front().Position), 0.0001f);
+			EXPECT_NEAR(linear.front().Distance, closest.Distance, 0.0001f);
+			EXPECT_NEAR(origin.Distance(linear.front().Position), origin.Distance(closest.Position(ray)), 0.001f);
+
+			// Nothing lies in front of the closest hit.
+			if (closest.Distance > 0.0f)
+			{
+				Ray nearer = ray;
+				nearer.SetInterval(0.0f, closest.Distance * 0.5f);
+				EXPECT_FALSE(static_cast<bool>(IntersectClosest(bvh, nearer)));
+			}
+		}
+	}
+
+	// A ray starting inside a sphere hits its far side.
+	const std::vector<std::shared_ptr<Object>> sphere = { std::make_shared<Sphere>() };
+	const BVH single(sphere);
+	const Ray inside({ 0.0f, 0.0f, -5.0f }, { 0.0f, 0.0f, 1.0f }, 5.0f);
+	const auto far = IntersectClosest(single, inside);
+	ASSERT_TRUE(static_cast<bool>(far));
+	EXPECT_NEAR(far.Distance, 6.0f, 0.0001f);
+}
+
+TEST_F(RendererUnitTests, RayIntervalTest)
+{
+	const Ray ray({ 0.0f, 0.0f, -10.0f }, { 0.0f, -0.0f, 2.0f });
+	EXPECT_EQ(ray.GetInverseDirection()[2], 1.0f);
+	EXPECT_EQ(ray.GetInverseDirection()[0], Infinity);
+	EXPECT_EQ(ray.GetInverseDirection()[1], -Infinity);
+	EXPECT_EQ(ray.GetSign()[0], 0u);
+	EXPECT_EQ(ray.GetSign()[1], 1u);
+	EXPECT_EQ(ray.GetSign()[2], 0u);
+	EXPECT_EQ(ray.GetMinDistance(), 0.0f);
+	EXPECT_EQ(ray.GetMaxDistance(), Infinity);
+
+	// A sphere, cube and plane in a row along the ray at 9, 14 and 20.
+	Sphere sphere;
+	Cube cube;
+	cube.XForm.SetPosition({ 0.0f, 0.0f, 4.5f });
+	const Plane plane(2.0f, 2.0f, { 0.0f, 0.0f, 10.0f }, { 0.0f, 0.0f, -1.0f });
+
+	Ray limited = ray;
+	EXPECT_NEAR(sphere.Intersect(limited).Distance, 9.0f, 0.0001f);
+	EXPECT_NEAR(cube.Intersect(limited).Distance, 14.0f, 0.0001f);
+	EXPECT_NEAR(plane.Intersect(limited).Distance, 20.0f, 0.0001f);
+
+	// Starting the interval inside the sphere reports its far side, the others are cut off.
+	limited.SetInterval(9.5f, 15.0f);
+	EXPECT_NEAR(sphere.Intersect(limited).Distance, 11.0f, 0.0001f);
+	EXPECT_NEAR(cube.Intersect(limited).Distance, 14.0f, 0.0001f);
+	EXPECT_FALSE(plane.Intersect(limited).Hit);
+
+	limited.SetInterval(11.5f, 14.5f);
+	EXPECT_FALSE(sphere.Intersect(limited).Hit);
+	EXPECT_NEAR(cube.Intersect(limited).Distance, 14.0f, 0.0001f);
+	limited.SetInterval(14.5f, Infinity);
+	EXPECT_FALSE(cube.Intersect(limited).Hit);
+	EXPECT_NEAR(plane.Intersect(limited).Distance, 20.0f, 0.0001f);
+
+	// Box tests against a ray travelling backwards along every axis.
+	const Ray backwards({ 5.0f, 5.0f, 5.0f }, { -1.0f, -1.0f, -1.0f });
+	EXPECT_EQ(backwards.GetSign()[0] + backwards.GetSign()[1] + backwards.GetSign()[2], 3u);
+	const BoundingBox box = { Vector3(-1.0f), Vector3(1.0f) };
+	float distance = 0.0f;
+	EXPECT_TRUE(box.Intersect(backwards, 0.0f, Infinity, distance));
+	EXPECT_NEAR(distance, std::sqrt(3.0f) * 4.0f, 0.0001f);
+	EXPECT_FALSE(box.Intersect(backwards, 0.0f, 6.0f, distance));
+}
+
+TEST_F(RendererUnitTests, PrimitiveStoreTest)
+{
+	// Derived primitives may change how they are hit so the store has to call them.
+	class HollowSphere : public Sphere
+	{
+	public:
+		Intersection Intersect(const Ray& ray) const override
+		{
+			const auto intersection = Sphere::Intersect(ray);
+			return intersection.Distance > 1.0f ? intersection : Intersection();
+		}
+	};
+
+	std::vector<std::shared_ptr<Object>> objects;
+	for (Size i = 0; i < 120; ++i)
+	{
+		const Vector3 position = { (Random() - 0.5f) * 10.0f, (Random() - 0.5f) * 10.0f, (Random() - 0.5f) * 10.0f };
+		std::shared_ptr<Object> object;
+		switch (i % 5)
+		{
+		case 0: object = std::make_shared<Sphere>(); break;
+		case 1: object = std::make_shared<Cube>(); break;
+		case 2: object = std::make_shared<Plane>(Plane(1.0f, 1.0f, position, { Random() - 0.5f, 1.0f, Random() - 0.5f })); break;
+		case 3: object = std::make_shared<HollowSphere>(); break;
+		default:
+			object = std::make_shared<Mesh>(Mesh::Buffer3{ { -0.5f, 0.5f, 0.0f }, { 0.0f, 0.0f, 0.5f }, { 0.0f, 0.0f, 0.0f } }, std::vector<std::uint32_t>{ 0u, 1u, 2u });
+			break;
+		}
+		object->XForm.SetPosition(position);
+		objects.push_back(object);
+	}
+
+	EXPECT_EQ(PrimitiveStore::Classify(*objects[0]), PrimitiveStore::Type::Sphere);
+	EXPECT_EQ(PrimitiveStore::Classify(*objects[1]), PrimitiveStore::Type::Cube);
+	EXPECT_EQ(PrimitiveStore::Classify(*objects[2]), PrimitiveStore::Type::Plane);
+	EXPECT_EQ(PrimitiveStore::Classify(*objects[3]), PrimitiveStore::Type::Other);
+	EXPECT_EQ(PrimitiveStore::Classify(*objects[4]), PrimitiveStore::Type::Other);
+
+	BVH::Settings settings;
+	settings.MaxLeafSize = 8u;
+	settings.IntersectionCost = 0.1f;
+	const BVH bvh(objects, settings);
+	const auto& primitives = bvh.GetPrimitives();
+	ASSERT_EQ(primitives.Count(), objects.size());
+	for (const auto& node : bvh.GetNodes())
+	{
+		for (Size i = node.Offset + 1u; node.IsLeaf() && i < node.Offset + node.Count; ++i)
+		{
+			EXPECT_LE(primitives.GetType(i - 1u), primitives.GetType(i));
+		}
+	}
+
+	for (Size i = 0; i < 2000; ++i)
+	{
+		// Half of the rays start inside one of the spheres.
+		Vector3 origin = { (Random() - 0.5f) * 14.0f, (Random() - 0.5f) * 14.0f, (Random() - 0.5f) * 14.0f };
+		if (i % 2u == 0u)
+		{
+			origin = objects[(i % 24u) * 5u]->XForm.GetPosition() + Vector3(0.3f);
+		}
+		const Ray ray(origin, { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f });
+
+		Intersection expected;
+		for (const auto& object : objects)
+		{
+			const auto intersection = object->Intersect(ray);
+			if (intersection.Hit && intersection.Distance < expected.Distance)
+			{
+				expected = intersection;
+			}
+		}
+
+		const auto closest = bvh.Closest(ray);
+		ASSERT_EQ(expected.Hit, static_cast<bool>(closest));
+		if (expected.Hit)
+		{
+			EXPECT_EQ(expected.Object, closest.Object);
+			EXPECT_NEAR(expected.Distance, closest.Distance, 0.0001f);
+		}
+		Ray shadow = ray;
+		shadow.SetInterval(0.0f, 2.0f);
+		EXPECT_EQ(expected.Hit && expected.Distance < 2.0f, bvh.Occluded(shadow));
+	}
+}
+
+TEST_F(RendererUnitTests, SphereBatchTest)
+{
+	constexpr Size width = Sphere::BatchWidth;
+	std::array<float, width> x, y, z, radiusSquared, distances;
+	for (Size i = 0; i < 2000; ++i)
+	{
+		for (Size lane = 0; lane < width; ++lane)
+		{
+			x[lane] = (Random() - 0.5f) * 20.0f;
+			y[lane] = (Random() - 0.5f) * 20.0f;
+			z[lane] = (Random() - 0.5f) * 20.0f;
+			radiusSquared[lane] = Random() * 16.0f;
+		}
+
+		// Some rays start inside a sphere and some have a limited interval.
+		Vector3 origin = { (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f };
+		if (i % 3u == 0u)
+		{
+			origin = { x[0] + 0.1f, y[0], z[0] - 0.1f };
+		}
+		Ray ray(origin, { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f });
+		if (i % 4u == 0u)
+		{
+			ray.SetInterval(Random() * 2.0f, 4.0f + Random() * 10.0f);
+		}
+
+		Sphere::HitDistances(x.data(), y.data(), z.data(), radiusSquared.data(), ray, distances.data());
+		for (Size lane = 0; lane < width; ++lane)
+		{
+			const float expected = Sphere::HitDistance({ { x[lane], y[lane], z[lane] }, radiusSquared[lane] }, ray);
+			EXPECT_EQ(expected, distances[lane]);
+		}
+	}
+
+	// A flat list of spheres that does not fill the last batch.
+	std::vector<std::shared_ptr<Object>> spheres;
+	for (Size i = 0; i < width * 2u + 1u; ++i)
+	{
+		spheres.push_back(std::make_shared<Sphere>());
+		spheres.back()->XForm.SetPosition({ 0.0f, 0.0f, 3.0f * static_cast<float>(i) });
+	}
+	PrimitiveStore store;
+	store.Build(spheres);
+	Ray ray({ 0.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 1.0f });
+	HitRecord hit;
+	store.Closest(ray, 1u, spheres.size() - 1u, hit);
+	EXPECT_EQ(hit.Object, spheres[1].get());
+	EXPECT_NEAR(hit.Distance, 12.0f, 0.0001f);
+	ray.SetInterval(0.0f, 30.0f);
+	EXPECT_FALSE(store.Occluded(ray, spheres.size() - 1u, 1u));
+	ray.SetInterval(0.0f, 40.0f);
+	EXPECT_TRUE(store.Occluded(ray, spheres.size() - 1u, 1u));
+}
+
+TEST_F(RendererUnitTests, RayPacketTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	for (Size i = 0; i < 200; ++i)
+	{
+		std::shared_ptr<Object> object;
+		if (i % 2u == 0u)
+		{
+			object = std::make_shared<Sphere>();
+		}
+		else
+		{
+			object = std::make_shared<Cube>();
+		}
+		object->XForm.SetPosition({ (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f });
+		objects.push_back(object);
+	}
+	objects.push_back(std::make_shared<Plane>(Plane(40.0f, 40.0f, { 0.0f, -16.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	const BVH bvh(objects);
+
+	const auto check = [&](const RayPacket& packet)
+	{
+		std::array<HitRecord, RayPacket::Width> hits;
+		bvh.Closest(packet, hits);
+		for (Size i = 0; i < packet.Count(); ++i)
+		{
+			const auto& ray = packet.Rays[i];
+			const auto expected = bvh.Closest(ray);
+			EXPECT_EQ(expected.Object, hits[i].Object);
+			EXPECT_EQ(expected.Distance, hits[i].Distance);
+		}
+	};
+
+	// Camera rays share an origin and are coherent, random rays are not.
+	Camera camera(64u, 64u, 1.0f, 0.05f);
+	camera.XForm.SetPosition({ 0.0f, 2.0f, 40.0f });
+	camera.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+	RayPacket packet;
+	for (Size block = 0; block < 64u * 64u; block += RayPacket::Width)
+	{
+		packet.Clear();
+		for (Size i = block; i < block + RayPacket::Width; ++i)
+		{
+			packet.Push(camera.CreateRay(i));
+		}
+		check(packet);
+	}
+
+	Size coherent = 0u;
+	for (Size i = 0; i < 200; ++i)
+	{
+		packet.Clear();
+		const Size count = 1u + (i % RayPacket::Width);
+		for (Size j = 0; j < count; ++j)
+		{
+			Ray ray({ (Random() - 0.5f) * 40.0f, (Random() - 0.5f) * 40.0f, (Random() - 0.5f) * 40.0f }, { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f });
+			ray.SetInterval(Random(), 10.0f + Random() * 30.0f);
+			packet.Push(ray);
+		}
+		coherent += packet.Coherent ? 1u : 0u;
+		check(packet);
+	}
+	EXPECT_EQ(coherent, 13u);
+	while (packet.Count() < RayPacket::Width)
+	{
+		packet.Push(packet.Rays.front());
+	}
+	EXPECT_THROW(packet.Push(packet.Rays.front()), std::runtime_error);
+
+	// Packet tracing renders the same image.
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 20.0f, 10.0f });
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(21u, 18u, 1.0f, 0.1f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 2.0f, 40.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	RayTracer::Settings settings;
+	settings.SamplesPerPixel = 2u;
+	settings.MaxGIDepth = 1u;
+	settings.SecondryBounces = 2u;
+	settings.TileSize = 10u;
+	RayTracer scalar(scene, settings);
+	settings.PacketTracing = true;
+	RayTracer packets(scene, settings);
+	const auto& expected = scalar.Render();
+	const auto& actual = packets.Render();
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		for (Size c = 0; c < 3; ++c)
+		{
+			EXPECT_EQ(expected.GetPixelValue(i)[c], actual.GetPixelValue(i)[c]);
+		}
+	}
+}
+
+TEST_F(RendererUnitTests, WavefrontTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	objects.push_back(std::make_shared<Plane>(Plane(10.0f, 10.0f, { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	for (Size i = 0; i < 3; ++i)
+	{
+		auto sphere = std::make_shared<Sphere>();
+		sphere->XForm.SetPosition({ -2.0f + (2.0f * static_cast<float>(i)), 0.0f, 0.0f });
+		sphere->Material.Albedo = { 0.8f, 0.8f, 0.8f };
+		sphere->Material.Metalness = 0.0f;
+		objects.push_back(sphere);
+	}
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 4.0f, 2.0f });
+	light->Intensity = 20.0f;
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(20u, 20u, 1.0f, 0.1f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 1.0f, 6.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	const auto render = [&](RayTracer::Settings settings)
+	{
+		RayTracer tracer(scene, settings);
+		return tracer.Render().GetPixels();
+	};
+	const auto mean = [](const Viewport::Pixels& pixels)
+	{
+		double sum = 0.0;
+		for (const auto& channel : pixels)
+		{
+			for (Size i = 0; i < channel.Area(); ++i)
+			{
+				sum += channel[i];
+			}
+		}
+		return sum / static_cast<double>(pixels.size() * pixels[0].Area());
+	};
+
+	// Without indirect light both integrators draw the same random numbers for every sample.
+	RayTracer::Settings settings;
+	settings.SamplesPerPixel = 4u;
+	settings.MaxGIDepth = 0u;
+	settings.TileSize = 8u;
+	const auto recursive = render(settings);
+	settings.Mode = RayTracer::Integrator::Wavefront;
+	settings.WavefrontSize = 7u;
+	const auto wavefront = render(settings);
+	for (Size c = 0; c < recursive.size(); ++c)
+	{
+		for (Size i = 0; i < recursive[c].Area(); ++i)
+		{
+			EXPECT_NEAR(recursive[c][i], wavefront[c][i], 0.0001f);
+		}
+	}
+
+	// With indirect light the estimate is the same but the bounces draw different random numbers.
+	settings.SamplesPerPixel = 16u;
+	settings.MaxGIDepth = 1u;
+	settings.SecondryBounces = 4u;
+	settings.WavefrontSize = 1u << 16u;
+	settings.PacketTracing = true;
+	const auto indirect = render(settings);
+	settings.WavefrontSize = 13u;
+	settings.PacketTracing = false;
+	const auto batched = render(settings);
+	for (Size c = 0; c < indirect.size(); ++c)
+	{
+		for (Size i = 0; i < indirect[c].Area(); ++i)
+		{
+			EXPECT_NEAR(indirect[c][i], batched[c][i], 0.0001f);
+		}
+	}
+	settings.Mode = RayTracer::Integrator::Recursive;
+	EXPECT_NEAR(mean(render(settings)), mean(indirect), mean(indirect) * 0.01);
+	EXPECT_GT(mean(indirect), mean(recursive));
+}
+
+TEST_F(RendererUnitTests, PathTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	objects.push_back(std::make_shared<Plane>(Plane(10.0f, 10.0f, { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	for (Size i = 0; i < 3; ++i)
+	{
+		auto sphere = std::make_shared<Sphere>();
+		sphere->XForm.SetPosition({ -2.0f + (2.0f * static_cast<float>(i)), 0.0f, 0.0f });
+		sphere->Material.Albedo = { 0.8f, 0.8f, 0.8f };
+		sphere->Material.Metalness = 0.0f;
+		objects.push_back(sphere);
+	}
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 4.0f, 2.0f });
+	light->Intensity = 20.0f;
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(20u, 20u, 1.0f, 0.1f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 1.0f, 6.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	const auto mean = [&](const RayTracer::Settings& settings)
+	{
+		RayTracer tracer(scene, settings);
+		double sum = 0.0;
+		for (const auto& channel : tracer.Render().GetPixels())
+		{
+			for (Size i = 0; i < channel.Area(); ++i)
+			{
+				sum += channel[i];
+			}
+		}
+		return sum / (3.0 * 20.0 * 20.0);
+	};
+
+	// One bounce per hit converges to the same image as the branching recursion.
+	RayTracer::Settings settings;
+	settings.SamplesPerPixel = 32u;
+	settings.MaxGIDepth = 1u;
+	settings.SecondryBounces = 8u;
+	const double recursive = mean(settings);
+	settings.Mode = RayTracer::Integrator::Path;
+	const double path = mean(settings);
+	EXPECT_NEAR(recursive, path, recursive * 0.01);
+
+	// Deeper paths add light, roulette keeps the estimate the same.
+	settings.MaxGIDepth = 8u;
+	settings.MaxDepth = 8u;
+	settings.RouletteDepth = 100u;
+	const double deep = mean(settings);
+	EXPECT_GT(deep, path);
+	settings.RouletteDepth = 1u;
+	const double roulette = mean(settings);
+	EXPECT_NEAR(roulette, deep, deep * 0.01);
+
+	settings.PacketTracing = true;
+	EXPECT_NEAR(mean(settings), roulette, 0.000001);
+}
+
+TEST_F(RendererUnitTests, AdaptiveTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	objects.push_back(std::make_shared<Plane>(Plane(4.0f, 4.0f, { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	auto sphere = std::make_shared<Sphere>();
+	sphere->Material.Albedo = { 0.8f, 0.8f, 0.8f };
+	sphere->Material.Metalness = 0.0f;
+	objects.push_back(sphere);
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 4.0f, 2.0f });
+	light->Intensity = 20.0f;
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(24u, 24u, 1.0f, 0.04f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 2.0f, 6.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	RayTracer::Settings settings;
+	settings.Mode = RayTracer::Integrator::Path;
+	settings.SamplesPerPixel = 256u;
+	settings.TileSize = 8u;
+	RayTracer reference(scene, settings);
+	const auto& expected = reference.Render();
+
+	settings.SamplesPerPixel = 16u;
+	RayTracer uniform(scene, settings);
+	const auto& flat = uniform.Render();
+	for (Size i = 0; i < flat.Area(); ++i)
+	{
+		EXPECT_EQ(uniform.GetSampleCounts()[i], 16u);
+	}
+
+	settings.Adaptive = true;
+	settings.MinSamples = 8u;
+	settings.MaxSamples = 64u;
+	settings.ErrorThreshold = 0.0002f;
+	RayTracer adaptive(scene, settings);
+	const auto& actual = adaptive.Render();
+	const auto& counts = adaptive.GetSampleCounts();
+
+	// The background never varies and keeps the minimum, its budget goes to the noisy pixels.
+	Size total = 0u;
+	Size maximum = 0u;
+	double uniformError = 0.0;
+	double adaptiveError = 0.0;
+	for (Size i = 0; i < actual.Area(); ++i)
+	{
+		EXPECT_GE(counts[i], settings.MinSamples);
+		EXPECT_LE(counts[i], settings.MaxSamples);
+		if (expected.GetPixelValue(i)[0] == 0.0f)
+		{
+			EXPECT_EQ(counts[i], settings.MinSamples);
+		}
+		total += counts[i];
+		maximum = std::max(maximum, counts[i]);
+		uniformError += std::abs(flat.GetPixelValue(i)[0] - expected.GetPixelValue(i)[0]);
+		adaptiveError += std::abs(actual.GetPixelValue(i)[0] - expected.GetPixelValue(i)[0]);
+	}
+	EXPECT_LE(total, actual.Area() * settings.SamplesPerPixel);
+	EXPECT_GT(maximum, settings.SamplesPerPixel);
+	EXPECT_LT(adaptiveError, uniformError);
+}
+
+TEST_F(RendererUnitTests, ProgressiveTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	objects.push_back(std::make_shared<Plane>(Plane(10.0f, 10.0f, { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	objects.push_back(std::make_shared<Sphere>());
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 4.0f, 2.0f });
+	light->Intensity = 20.0f;
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(16u, 12u, 1.0f, 0.1f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 2.0f, 6.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	RayTracer::Settings settings;
+	settings.SamplesPerPixel = 5u;
+	settings.MaxGIDepth = 1u;
+	settings.SecondryBounces = 2u;
+	settings.TileSize = 5u;
+	RayTracer blocking(scene, settings);
+	const auto& expected = blocking.Render();
+
+	// Without a budget the passes add up to the same image, with a snapshot after each pass.
+	settings.Progressive = true;
+	settings.PassSamples = 2u;
+	Size snapshots = 0u;
+	RayTracer progressive(scene, settings);
+	const auto& actual = progressive.Render([&](const Viewport::Pixels&, const std::string&) { ++snapshots; });
+	EXPECT_EQ(snapshots, 3u);
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		EXPECT_EQ(progressive.GetSampleCounts()[i], 5u);
+		for (Size c = 0; c < 3; ++c)
+		{
+			EXPECT_EQ(expected.GetPixelValue(i)[c], actual.GetPixelValue(i)[c]);
+		}
+	}
+
+	// The sample budget stops before the pass that would go over it.
+	settings.SampleBudget = expected.Area() * 3u;
+	RayTracer budget(scene, settings);
+	budget.Render();
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		EXPECT_EQ(budget.GetSampleCounts()[i], 2u);
+	}
+
+	// A sample budget smaller than one pass still gets the whole first pass.
+	settings.SampleBudget = expected.Area();
+	snapshots = 0u;
+	RayTracer small(scene, settings);
+	small.Render([&](const Viewport::Pixels&, const std::string&) { ++snapshots; });
+	EXPECT_EQ(snapshots, 1u);
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		EXPECT_EQ(small.GetSampleCounts()[i], settings.PassSamples);
+	}
+
+	// The time budget stops an otherwise very long render on a pass boundary of each tile.
+	settings.SampleBudget = 0u;
+	settings.SamplesPerPixel = 1000000u;
+	settings.TimeBudget = std::chrono::milliseconds(50);
+	RayTracer timed(scene, settings);
+	const auto start = std::chrono::steady_clock::now();
+	timed.Render();
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		EXPECT_LT(timed.GetSampleCounts()[i], settings.SamplesPerPixel);
+		EXPECT_EQ(timed.GetSampleCounts()[i] % settings.PassSamples, 0u);
+	}
+
+	// A budget that runs out during the first pass still leaves no pixel without samples.
+	settings.TimeBudget = std::chrono::milliseconds(1);
+	RayTracer rushed(scene, settings);
+	rushed.Render();
+	for (Size i = 0; i < expected.Area(); ++i)
+	{
+		EXPECT_GE(rushed.GetSampleCounts()[i], settings.PassSamples);
+	}
+}
+
+TEST_F(RendererUnitTests, SamplerTest)
+{
+	constexpr Size count = 64u;
+	const std::vector<SamplerType> types = { SamplerType::Stratified, SamplerType::Sobol, SamplerType::Halton };
+	for (const auto type : types)
+	{
+		// Each of the first dimensions puts exactly one of the pixel's samples in every 1/count
+		// interval, Halton only does so for its base 2 dimension.
+		const Size stratified = type == SamplerType::Halton ? 1u : 4u;
+		auto sampler = CreateSampler(type);
+		for (std::uint64_t pixel = 0; pixel < 8u; ++pixel)
+		{
+			std::vector<std::vector<Size>> bins(stratified, std::vector<Size>(count, 0u));
+			for (Size i = 0; i < count; ++i)
+			{
+				sampler->Start(pixel, i, count, 3u);
+				for (Size d = 0; d < 40u; ++d)
+				{
+					const float value = sampler->Next();
+					ASSERT_GE(value, 0.0f);
+					ASSERT_LT(value, 1.0f);
+					if (d < stratified)
+					{
+						++bins[d][static_cast<Size>(value * count)];
+					}
+				}
+			}
+			for (const auto& bin : bins)
+			{
+				EXPECT_EQ(std::count(bin.begin(), bin.end(), 1u), static_cast<std::ptrdiff_t>(count));
+			}
+		}
+	}
+
+	// Integrating a smooth function over a later pair of dimensions of many pixels has a smaller
+	// error than independent numbers.
+	const auto error = [](const SamplerType type)
+	{
+		constexpr Size samples = 16u;
+		constexpr Size pixels = 256u;
+		auto sampler = CreateSampler(type);
+		double squares = 0.0;
+		for (std::uint64_t pixel = 0; pixel < pixels; ++pixel)
+		{
+			double sum = 0.0;
+			for (Size i = 0; i < samples; ++i)
+			{
+				sampler->Start(pixel, i, samples, 0u);
+				sampler->Next();
+				sampler->Next();
+				const float x = sampler->Next();
+				const float y = sampler->Next();
+				sum += x * y;
+			}
+			const double difference = (sum / samples) - 0.25;
+			squares += difference * difference;
+		}
+		return std::sqrt(squares / pixels);
+	};
+	const double independent = error(SamplerType::Independent);
+	for (const auto type : types)
+	{
+		EXPECT_LT(error(type), independent * 0.75);
+	}
+
+	// Random draws from the sampler while one is set on the thread.
+	auto sampler = CreateSampler(SamplerType::Sobol);
+	auto copy = CreateSampler(SamplerType::Sobol);
+	sampler->Start(5u, 3u, 16u, 1u);
+	copy->Start(5u, 3u, 16u, 1u);
+	SetThreadSampler(sampler.get());
+	EXPECT_EQ(ThreadSampler(), sampler.get());
+	EXPECT_EQ(Random(), copy->Next());
+	EXPECT_EQ(Random(), copy->Next());
+	SetThreadSampler(nullptr);
+	EXPECT_EQ(ThreadSampler(), nullptr);
+
+	// A render with a low discrepancy sampler is closer to a converged image at the same sample count.
+	std::vector<std::shared_ptr<Object>> objects;
+	objects.push_back(std::make_shared<Plane>(Plane(10.0f, 10.0f, { 0.0f, -1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f })));
+	objects.push_back(std::make_shared<Sphere>());
+	auto light = std::make_shared<Lights::Point>();
+	light->XForm.SetPosition({ 0.0f, 4.0f, 2.0f });
+	light->Intensity = 20.0f;
+	std::vector<std::shared_ptr<Light>> lights = { light };
+	Scene scene(objects, lights, Camera(16u, 12u, 1.0f, 0.1f));
+	scene.Cam.XForm.SetPosition({ 0.0f, 2.0f, 6.0f });
+	scene.Cam.LookAt({ 0.0f, 0.0f, 0.0f }, Y_MINUS_AXIS);
+
+	RayTracer::Settings settings;
+	settings.Mode = RayTracer::Integrator::Path;
+	settings.MaxDepth = 2u;
+	settings.SamplesPerPixel = 256u;
+	settings.TileSize = 4u;
+	RayTracer converged(scene, settings);
+	const auto reference = converged.Render();
+
+	const auto renderError = [&](const SamplerType type)
+	{
+		settings.SamplesPerPixel = 16u;
+		settings.Seed = 1u;
+		settings.Sampling = type;
+		RayTracer tracer(scene, settings);
+		const auto& image = tracer.Render();
+		double squares = 0.0;
+		for (Size i = 0; i < image.Area(); ++i)
+		{
+			for (Size c = 0; c < 3; ++c)
+			{
+				const double difference = image.GetPixelValue(i)[c] - reference.GetPixelValue(i)[c];
+				squares += difference * difference;
+			}
+		}
+		return squares;
+	};
+	EXPECT_LT(renderError(SamplerType::Sobol), renderError(SamplerType::Independent));
+}
+
+TEST_F(RendererUnitTests, AreaLightSamplingTest)
+{
+	auto light = std::make_shared<Lights::Area>(2.0f, 2.0f, 64u);
+	light->Intensity = 5.0f;
+	light->ShadowIntensity = 1.0f;
+	light->Grid->XForm.SetPosition({ 0.0f, 3.0f, 0.0f });
+	light->Grid->SetDirection(Y_MINUS_AXIS);
+	const Vector3 origin = { 0.5f, 0.0f, 0.2f };
+
+	// A point sampled on the light and the ray towards it agree on the density and distance.
+	SeedRandom(1u, 0u);
+	for (Size i = 0; i < 100; ++i)
+	{
+		const float u = Random();
+		const float v = Random();
+		const auto sample = light->SampleArea(origin, u, v);
+		ASSERT_GT(sample.Pdf, 0.0f);
+		float distance = 0.0f;
+		EXPECT_NEAR(light->Pdf(sample.IncomingRay, distance), sample.Pdf, sample.Pdf * 0.001f);
+		EXPECT_NEAR(distance, sample.Distance, 0.0001f);
+	}
+
+	// The density integrates to one over all directions.
+	constexpr Size count = 200000u;
+	double integral = 0.0;
+	for (Size i = 0; i < count; ++i)
+	{
+		const float z = 1.0f - (2.0f * Random());
+		const float phi = 6.2831853f * Random();
+		const float r = std::sqrt(std::max(1.0f - (z * z), 0.0f));
+		float distance = 0.0f;
+		integral += light->Pdf(Ray(origin, { r * std::cos(phi), z, r * std::sin(phi) }), distance);
+	}
+	EXPECT_NEAR(integral * 4.0 * 3.14159265 / count, 1.0, 0.05);
+
+	// Shading takes its shadows from the light samples, Shadow adds none of its own.
+	auto floor = std::make_shared<Plane>(Plane(10.0f, 10.0f, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }));
+	floor->Material.Albedo = { 0.8f, 0.8f, 0.8f };
+	floor->Material.Metalness = 0.0f;
+	floor->Material.Roughness = 0.5f;
+	auto blocker = std::make_shared<Sphere>();
+	blocker->Radius = 0.5f;
+	blocker->XForm.SetPosition({ 0.5f, 1.5f, 0.2f });
+	Scene open({ floor }, { light });
+	Scene blocked({ floor, blocker }, { light });
+	EXPECT_EQ(light->Shadow(blocked.Hierarchy, origin), 0.0f);
+
+	const Vector3 eye = { 0.5f, 2.0f, 3.0f };
+	const Ray ray(eye, origin - eye);
+	const auto hit = origin + (Y_AXIS * 0.0001f);
+	const auto shade = [&](const Scene& scene, double& deviation)
+	{
+		constexpr Size seeds = 64u;
+		std::vector<float> values;
+		for (Size seed = 0; seed < seeds; ++seed)
+		{
+			SeedRandom(seed, 0u);
+			values.push_back(floor->Material.BSDF(ray, Y_AXIS, hit, scene.Hierarchy, scene.Lights)[0]);
+		}
+		const double mean = std::accumulate(values.begin(), values.end(), 0.0) / seeds;
+		double squares = 0.0;
+		for (const auto value : values)
+		{
+			squares += (value - mean) * (value - mean);
+		}
+		deviation = std::sqrt(squares / seeds);
+		return mean;
+	};
+
+	double openDeviation = 0.0;
+	double blockedDeviation = 0.0;
+	const double lit = shade(open, openDeviation);
+	const double shadowed = shade(blocked, blockedDeviation);
+	EXPECT_GT(lit, 0.0);
+	EXPECT_LT(openDeviation, lit * 0.02);
+	EXPECT_LT(shadowed, lit * 0.75);
+}
+
+TEST_F(RendererUnitTests, RandomGeneratorTest)
+{
+	RandomGenerator a(42u, 7u);
+	RandomGenerator b(42u, 7u);
+	RandomGenerator c(43u, 7u);
+
+	float sum = 0.0f;
+	Size matches = 0u;
+	constexpr Size count = 10000u;
+	for (Size i = 0; i < count; ++i)
+	{
+		const float value = a.NextFloat();
+		ASSERT_EQ(value, b.NextFloat());
+		ASSERT_GE(value, 0.0f);
+		ASSERT_LT(value, 1.0f);
+		matches += value == c.NextFloat() ? 1u : 0u;
+		sum += value;
+	}
+	EXPECT_LT(matches, 10u);
+	EXPECT_NEAR(sum / static_cast<float>(count), 0.5f, 0.02f);
+
+	SeedRandom(1u, 2u);
+	const float first = Random();
+	SeedRandom(1u, 2u);
+	EXPECT_EQ(first, Random());
+}
+
+TEST_F(RendererUnitTests, TileOrderTest)
+{
+	constexpr Size columns = 100u;
+	constexpr Size rows = 70u;
+	constexpr Size tileSize = 16u;
+
+	for (const auto order : { TileOrder::Scanline, TileOrder::Morton, TileOrder::Hilbert })
+	{
+		const auto tiles = CreateTiles(columns, rows, tileSize, order);
+		ASSERT_EQ(tiles.size(), 7u * 5u);
+
+		std::vector<Size> coverage(columns * rows, 0u);
+		for (const auto& tile : tiles)
+		{
+			for (Size y = tile.Y; y < tile.Y + tile.Height; ++y)
+			{
+				for (Size x = tile.X; x < tile.X + tile.Width; ++x)
+				{
+					++coverage[(y * columns) + x];
+				}
+			}
+		}
+		EXPECT_TRUE(std::all_of(coverage.begin(), coverage.end(), [](const Size c) { return c == 1u; }));
+	}
+
+	// Consecutive tiles along a Hilbert curve always share an edge.
+	const auto hilbert = CreateTiles(128u, 128u, tileSize, TileOrder::Hilbert);
+	for (Size i = 1; i < hilbert.size(); ++i)
+	{
+		const Size dx = hilbert[i].X > hilbert[i - 1].X ? hilbert[i].X - hilbert[i - 1].X : hilbert[i - 1].X - hilbert[i].X;
+		const Size dy = hilbert[i].Y > hilbert[i - 1].Y ? hilbert[i].Y - hilbert[i - 1].Y : hilbert[i - 1].Y - hilbert[i].Y;
+		EXPECT_EQ(dx + dy, tileSize);
+	}
+}
+
+TEST_F(RendererUnitTests, BVHRefitTest)
+{
+	std::vector<std::shared_ptr<Object>> objects;
+	std::vector<std::shared_ptr<Sphere>> spheres;
+	for (Size i = 0; i < 100; ++i)
+	{
+		auto sphere = std::make_shared<Sphere>();
+		sphere->Radius = Random() + 0.1f;
+		sphere->XForm.SetPosition({ (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f });
+		objects.push_back(sphere);
+		spheres.push_back(sphere);
+	}
+
+	Scene scene(objects, {});
+	const auto check = [&]()
+	{
+		for (Size i = 0; i < 500; ++i)
+		{
+			const Vector3 origin = { (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f, (Random() - 0.5f) * 30.0f };
+			const Ray ray(origin, { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f });
+			const auto linear = IntersectScene(objects, ray, true);
+			const auto closest = IntersectClosest(scene.Hierarchy, ray);
+			ASSERT_EQ(linear.empty(), !static_cast<bool>(closest));
+			if (!linear.empty())
+			{
+				EXPECT_NEAR(linear.front().Distance, closest.Distance, 0.0001f);
+			}
+		}
+	};
+
+	// Small moves keep the topology, the tree is only refitted.
+	const auto nodes = scene.Hierarchy.GetNodes().size();
+	for (auto& sphere : spheres)
+	{
+		sphere->XForm.SetPosition(sphere->XForm.GetPosition() + Vector3(0.25f));
+	}
+	EXPECT_FALSE(scene.Hierarchy.Refit());
+	EXPECT_EQ(nodes, scene.Hierarchy.GetNodes().size());
+	check();
+
+	// Scrambling every position degrades the tree enough to trigger a rebuild.
+	for (auto& sphere : spheres)
+	{
+		sphere->XForm.SetPosition({ (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f, (Random() - 0.5f) * 20.0f });
+	}
+	EXPECT_TRUE(scene.Hierarchy.Refit());
+	check();
+
+	// Commit only does work once an object has been edited.
+	EXPECT_FALSE(scene.Hierarchy.Commit());
+	spheres.front()->Radius += 1.0f;
+	EXPECT_TRUE(scene.Hierarchy.Commit());
+	EXPECT_FALSE(scene.Hierarchy.Commit());
+	check();
+
+	objects.push_back(std::make_shared<Cube>());
+	scene.Objects = objects;
+	scene.Update();
+	EXPECT_EQ(scene.Hierarchy.GetObjects().size(), objects.size());
+	check();
+
+	// Replacing an object keeps the count but still needs a rebuild.
+	auto replacement = std::make_shared<Sphere>();
+	replacement->XForm.SetPosition({ 40.0f, 0.0f, 0.0f });
+	const auto removed = objects[1];
+	objects[1] = replacement;
+	scene.Objects = objects;
+	scene.Commit();
+	const auto replaced = IntersectClosest(scene.Hierarchy, Ray({ 40.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 1.0f }));
+	ASSERT_TRUE(static_cast<bool>(replaced));
+	EXPECT_EQ(replaced.Object, replacement.get());
+	const auto& committed = scene.Hierarchy.GetObjects();
+	EXPECT_EQ(std::find(committed.begin(), committed.end(), removed), committed.end());
+	check();
+}
+
+TEST_F(RendererUnitTests, InstanceTest)
+{
+	// One sphere and one cube shared by every instance, compared against explicitly placed copies.
+	auto sphere = std::make_shared<Sphere>();
+	sphere->Radius = 0.5f;
+	sphere->XForm.SetPosition({ 0.0f, 1.0f, 0.0f });
+	auto cube = std::make_shared<Cube>();
+	cube->XForm.SetPosition({ 0.0f, -1.0f, 0.0f });
+	const auto geometry = std::make_shared<const BVH>(std::vector<std::shared_ptr<Object>>{ sphere, cube });
+
+	std::vector<std::shared_ptr<Object>> instances;
+	std::vector<std::shared_ptr<Object>> copies;
+	for (Size i = 0; i < 50; ++i)
+	{
+		const Vector3 position = { (Random() - 0.5f) * 40.0f, (Random() - 0.5f) * 40.0f, (Random() - 0.5f) * 40.0f };
+		const float scale = Random() + 0.5f;
+		Matrix3 axis;
+		axis.Identity();
+		axis *= scale;
+
+		instances.push_back(std::make_shared<Instance>(geometry, Transform(axis, position, true)));
+
+		auto sphereCopy = std::make_shared<Sphere>();
+		sphereCopy->Radius = sphere->Radius * scale;
+		sphereCopy->XForm.SetPosition(position + (sphere->XForm.GetPosition() * scale));
+		auto cubeCopy = std::make_shared<Cube>();
+		cubeCopy->Width = scale;
+		cubeCopy->Height = scale;
+		cubeCopy->Length = scale;
+		cubeCopy->XForm.SetPosition(position + (cube->XForm.GetPosition() * scale));
+		copies.push_back(sphereCopy);
+		copies.push_back(cubeCopy);
+	}
+
+	const BVH instanced(instances);
+	const BVH flat(copies);
+	for (Size i = 0; i < 2000; ++i)
+	{
+		const Vector3 origin = { (Random() - 0.5f) * 60.0f, (Random() - 0.5f) * 60.0f, (Random() - 0.5f) * 60.0f };
+		const Ray ray(origin, { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f });
+
+		const auto expected = IntersectClosest(flat, ray);
+		const auto actual = IntersectClosest(instanced, ray);
+		ASSERT_EQ(static_cast<bool>(expected), static_cast<bool>(actual));
+		EXPECT_EQ(static_cast<bool>(actual), actual.Instance != nullptr);
+		if (expected)
+		{
+			EXPECT_NEAR(expected.Distance, actual.Distance, 0.001f);
+			EXPECT_TRUE(actual.Object == sphere.get() || actual.Object == cube.get());
+
+			const auto position = actual.Position(ray);
+			EXPECT_NEAR(expected.Normal(position).DotProduct(actual.Normal(position)), 1.0f, 0.001f);
+		}
+		EXPECT_EQ(static_cast<bool>(expected), IsOccluded(instanced, ray));
+	}
+}
+
+TEST_F(RendererUnitTests, MeshTest)
+{
+	// A unit cube with every face split into a grid of triangles, it must match the Cube primitive.
+	constexpr Size divisions = 8u;
+	Mesh::Buffer3 positions;
+	std::vector<std::uint32_t> indices;
+	for (Size axis = 0; axis < 3; ++axis)
+	{
+		for (const float side : { -0.5f, 0.5f })
+		{
+			const auto first = static_cast<std::uint32_t>(positions.Count());
+			for (Size i = 0; i <= divisions; ++i)
+			{
+				for (Size j = 0; j <= divisions; ++j)
+				{
+					Vector3 position;
+					position[axis] = side;
+					position[(axis + 1u) % 3u] = (static_cast<float>(i) / static_cast<float>(divisions)) - 0.5f;
+					position[(axis + 2u) % 3u] = (static_cast<float>(j) / static_cast<float>(divisions)) - 0.5f;
+					positions.Push(position);
+				}
+			}
+
+			for (Size i = 0; i < divisions; ++i)
+			{
+				for (Size j = 0; j < divisions; ++j)
+				{
+					const auto corner = first + static_cast<std::uint32_t>((i * (divisions + 1u)) + j);
+					const auto next = corner + static_cast<std::uint32_t>(divisions + 1u);
+					indices.insert(indices.end(), { corner, next, corner + 1u, next, next + 1u, corner + 1u });
+				}
+			}
+		}
+	}
+
+	const auto mesh = std::make_shared<Mesh>(positions, indices);
+	ASSERT_EQ(mesh->TriangleCount(), 6u * divisions * divisions * 2u);
+	EXPECT_NEAR(mesh->Bounds().SurfaceArea(), 6.0f, 0.0001f);
+
+	const Cube cube;
+	Size mismatches = 0u;
+	for (Size i = 0; i < 2000; ++i)
+	{
+		// Origins outside the cube aimed at points around it.
+		Vector3 origin = { Random() - 0.5f, Random() - 0.5f, Random() - 0.5f };
+		origin = origin.Normalized() * 3.0f;
+		const Vector3 target = { (Random() - 0.5f) * 1.2f, (Random() - 0.5f) * 1.2f, (Random() - 0.5f) * 1.2f };
+		const Ray ray(origin, target - origin);
+
+		const auto expected = cube.Intersect(ray);
+		const auto actual = mesh->Intersect(ray);
+		if (expected.Hit != actual.Hit)
+		{
+			// Only rays grazing an edge may disagree.
+			++mismatches;
+			continue;
+		}
+
+		if (expected.Hit)
+		{
+			EXPECT_EQ(actual.Object, mesh.get());
+			EXPECT_NEAR(expected.Distance, actual.Distance, 0.001f);
+			EXPECT_NEAR(std::abs(cube.CalculateNormal(expected.Position).DotProduct(actual.Normal())), 1.0f, 0.001f);
+		}
+	}
+	EXPECT_LE(mismatches, 2u);
+}
+
+TEST_F(RendererUnitTests, ImporterTest)
+{
+	const auto directory = std::filesystem::temp_directory_path();
+
+	// A unit square as a quad and as two triangles with negative indices, comments and
+	// normals in between. A small chunk size splits the file across several jobs.
+	const std::string objPath = (directory / "RendererImporterTest.obj").string();
+	{
+		std::ofstream obj(objPath, std::ios::binary);
+		obj << "# square\n";
+		for (Size i = 0; i < 20; ++i)
+		{
+			const float z = static_cast<float>(i);
+			obj << "v -0.5 -0.5 " << z << "\nv 0.5 -0.5 " << z << "\r\nv  0.5 0.5 " << z << "\nv -0.5 +0.5 " << z << " 1.0\n";
+			obj << "vn 0 0 1\nvn 0 0 1\nvn 0 0 1\nvn 0 0 1\n";
+			if (i % 2u == 0u)
+			{
+				obj << "f " << (i * 4u) + 1u << "/1/1 " << (i * 4u) + 2u << "//2 " << (i * 4u) + 3u << " " << (i * 4u) + 4u << "\n";
+			}
+			else
+			{
+				obj << "f -4 -3 -2\nf -4 -2 -1 # second half\n";
+			}
+		}
+	}
+
+	const auto obj = LoadOBJ(objPath, 64u);
+	ASSERT_EQ(obj->Positions.Count(), 80u);
+	ASSERT_EQ(obj->Normals.Count(), 80u);
+	ASSERT_EQ(obj->TriangleCount(), 40u);
+	EXPECT_EQ(obj->UVs.Count(), 0u);
+	for (Size i = 0; i < obj->TriangleCount(); ++i)
+	{
+		// Every triangle stays within its own square.
+		const auto square = obj->Indices[i * 3u] / 4u;
+		EXPECT_EQ(obj->Indices[(i * 3u) + 1u] / 4u, square);
+		EXPECT_EQ(obj->Indices[(i * 3u) + 2u] / 4u, square);
+	}
+
+	const auto hit = obj->Intersect(Ray({ 0.2f, 0.1f, -5.0f }, { 0.0f, 0.0f, 1.0f }));
+	ASSERT_TRUE(hit.Hit);
+	EXPECT_NEAR(hit.Distance, 5.0f, 0.0001f);
+	EXPECT_NEAR(obj->Bounds().Max[2], 19.0f, 0.0001f);
+	EXPECT_EQ(LoadMesh(objPath)->TriangleCount(), 40u);
+
+	// The same squares as big endian PLY with the last face left as a quad, which stops the
+	// parallel all triangle path part way through.
+	const std::string plyPath = (directory / "RendererImporterTest.ply").string();
+	{
+		std::ofstream ply(plyPath, std::ios::binary);
+		ply << "ply\nformat binary_big_endian 1.0\ncomment test\nelement vertex 80\nproperty float x\nproperty float y\nproperty float z\n"
+			"property uchar flags\nproperty float u\nproperty float v\nelement face 39\nproperty list uchar int vertex_indices\nend_header\n";
+		const auto write = [&](auto value)
+		{
+			std::array<char, sizeof(value)> bytes;
+			std::memcpy(bytes.data(), &value, sizeof(value));
+			std::reverse(bytes.begin(), bytes.end());
+			ply.write(bytes.data(), bytes.size());
+		};
+
+		for (Size i = 0; i < 80u; ++i)
+		{
+			const Vector3 position = obj->Positions.Get(i);
+			write(position[0]);
+			write(position[1]);
+			write(position[2]);
+			write(std::uint8_t(7u));
+			write(position[0] + 0.5f);
+			write(position[1] + 0.5f);
+		}
+		for (Size i = 0; i + 2u < obj->TriangleCount(); ++i)
+		{
+			write(std::uint8_t(3u));
+			write(static_cast<std::int32_t>(obj->Indices[(i * 3u) + 0u]));
+			write(static_cast<std::int32_t>(obj->Indices[(i * 3u) + 1u]));
+			write(static_cast<std::int32_t>(obj->Indices[(i * 3u) + 2u]));
+		}
+		write(std::uint8_t(4u));
+		write(std::int32_t(76));
+		write(std::int32_t(77));
+		write(std::int32_t(78));
+		write(std::int32_t(79));
+	}
+
+	const auto ply = LoadMesh(plyPath);
+	ASSERT_EQ(ply->Positions.Count(), 80u);
+	ASSERT_EQ(ply->UVs.Count(), 80u);
+	EXPECT_EQ(ply->Normals.Count(), 0u);
+	ASSERT_EQ(ply->Indices, obj->Indices);
+	EXPECT_NEAR(ply->Positions.Get(42u).Distance(obj->Positions.Get(42u)), 0.0f, 0.0001f);
+	EXPECT_NEAR(ply->UVs.Get(6u)[0], obj->Positions.Get(6u)[0] + 0.5f, 0.0001f);
+
+	// Little endian with a quad in the middle and chunks of a few faces, so chunks after the
+	// quad read faces at the wrong offsets before the all triangle path is abandoned.
+	{
+		std::ofstream ply(plyPath, std::ios::binary);
+		ply << "ply\nformat binary_little_endian 1.0\nelement vertex 80\nproperty float x\nproperty float y\nproperty float z\n"
+			"element face 39\nproperty list uchar int vertex_indices\nend_header\n";
+		const auto write = [&](auto value)
+		{
+			std::array<char, sizeof(value)> bytes;
+			std::memcpy(bytes.data(), &value, sizeof(value));
+			ply.write(bytes.data(), bytes.size());
+		};
+
+		for (Size i = 0; i < 80u; ++i)
+		{
+			const Vector3 position = obj->Positions.Get(i);
+			write(position[0]);
+			write(position[1]);
+			write(position[2]);
+		}
+		for (Size square = 0; square < 20u; ++square)
+		{
+			const auto first = static_cast<std::int32_t>(square * 4u);
+			if (square == 10u)
+			{
+				write(std::uint8_t(4u));
+				write(first);
+				write(first + 1);
+				write(first + 2);
+				write(first + 3);
+				continue;
+			}
+			write(std::uint8_t(3u));
+			write(first);
+			write(first + 1);
+			write(first + 2);
+			write(std::uint8_t(3u));
+			write(first);
+			write(first + 2);
+			write(first + 3);
+		}
+	}
+
+	const auto middle = LoadPLY(plyPath, 32u);
+	ASSERT_EQ(middle->TriangleCount(), 40u);
+	for (Size i = 0; i < middle->TriangleCount(); ++i)
+	{
+		const auto square = middle->Indices[i * 3u] / 4u;
+		EXPECT_EQ(square, i / 2u);
+		EXPECT_EQ(middle->Indices[(i * 3u) + 1u] / 4u, square);
+		EXPECT_EQ(middle->Indices[(i * 3u) + 2u] / 4u, square);
+	}
+
+	std::filesystem::remove(objPath);
+	std::filesystem::remove(plyPath);
+	EXPECT_THROW(LoadMesh(objPath), std::runtime_error);
+}
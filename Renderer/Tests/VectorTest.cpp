@@ -19,6 +19,20 @@ TEST_F(VectorUnitTests, Test_Good)
 	EXPECT_NEAR(a.Length(), 1.0f, 0.1f) << "Length: " << a.Length();
 }
 
+TEST_F(VectorUnitTests, Test_Constexpr)
+{
+	using Renderer::Math::Vector3;
+	static_assert(std::is_trivially_copyable<Vector3>::value, "Vector3 should be trivially copyable.");
+
+	constexpr Vector3 a = { 1.0f, 2.0f, 3.0f };
+	constexpr Vector3 b = Renderer::Math::X_AXIS.CrossProduct(Renderer::Math::Y_AXIS);
+	constexpr float dot = (a * 2.0f + 1.0f).DotProduct(b);
+	static_assert(dot == 7.0f, "Constant evaluated dot product.");
+
+	EXPECT_EQ(b[2], 1.0f);
+	EXPECT_NEAR(a.Distance(Vector3()), std::sqrt(14.0f), 0.0001f);
+}
+
 using namespace Renderer;
 
 TEST_F(VectorUnitTests, Test_Logger)
@@ -146,4 +160,38 @@ TEST_F(VectorUnitTests, GaussEliminationGood)
 
 	int aaa = 0;
 
+}
+
+TEST_F(VectorUnitTests, SquareMatrixInverse)
+{
+	using namespace Renderer::Math;
+
+	const Matrix3 a = { { 1.0f, 1.0f, 1.0f }, { 2.0f, 4.0f, 0.0f }, { 2.0f, 8.0f, 1.0f } };
+	const Matrix4 b = { { 2.0f, 0.0f, 1.0f, 3.0f }, { 1.0f, 1.0f, 0.0f, 2.0f }, { 0.0f, 4.0f, 1.0f, 1.0f }, { 3.0f, 1.0f, 2.0f, 1.0f } };
+
+	const auto identity3 = a.Multiply(a.Inversed());
+	const auto identity4 = b.Multiply(b.Inversed());
+	for (Size r = 0; r < 4; ++r)
+	{
+		for (Size c = 0; c < 4; ++c)
+		{
+			const float expected = r == c ? 1.0f : 0.0f;
+			if (r < 3 && c < 3)
+			{
+				EXPECT_NEAR(identity3.Get(c, r), expected, 0.0001f);
+			}
+			EXPECT_NEAR(identity4.Get(c, r), expected, 0.0001f);
+		}
+	}
+
+	const Matrix<float> dynamic = { { 1.0f, 1.0f, 1.0f }, { 2.0f, 4.0f, 0.0f }, { 2.0f, 8.0f, 1.0f } };
+	EXPECT_NEAR(a.Determinant(), dynamic.Determinant(), 0.0001f);
+
+	const Vector3 v = { 1.0f, 2.0f, 3.0f };
+	const auto transformed = v.MatrixMultiply(a);
+	const auto expected = v.MatrixMultiply(dynamic);
+	for (Size i = 0; i < 3; ++i)
+	{
+		EXPECT_FLOAT_EQ(transformed[i], expected[i]);
+	}
 }
\ No newline at end of file